@@ -0,0 +1,94 @@
+using System;
+using System.Linq;
+using BenchmarkDotNet.Attributes;
+using Interface;
+using SharpGen.Runtime;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Calls of managed callbacks through their shadows, from the generated wrapper of the native view.
+/// </summary>
+[MemoryDiagnoser]
+public class CallbackBenchmarks
+{
+    private ManagedCallback target;
+    private CallbackInterfaceNative nativeView;
+    private readonly int[] values = Enumerable.Range(0, 16).ToArray();
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        RuntimeSetup.Initialize();
+
+        target = new ManagedCallback();
+        nativeView = new CallbackInterfaceNative(MarshallingHelpers.ToCallbackPtr<CallbackInterface>(target));
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        nativeView.Dispose();
+        target.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public int Call() => nativeView.Add(1, 2);
+
+    [Benchmark]
+    public LargeStruct StructReturn() => nativeView.GetLargeStruct(4, 10);
+
+    [Benchmark]
+    public byte StringParameter() => nativeView.GetFirstAnsiCharacter("ABC");
+
+    [Benchmark]
+    public int RelationArrayParameter() => nativeView.ArrayRelationSum(values);
+
+    [Benchmark]
+    public IntPtr QueryInterface() => target.Find<CallbackInterface>();
+
+    [Benchmark]
+    public IntPtr CreateAndDispose()
+    {
+        using ManagedCallback callback = new();
+        return MarshallingHelpers.ToCallbackPtr<CallbackInterface>(callback);
+    }
+
+    private sealed class ManagedCallback : CallbackBase, CallbackInterface
+    {
+        public int Add(int i, int j) => i + j;
+
+        public bool AreEqual(CallbackInterface rhs) => ReferenceEquals(this, rhs);
+
+        public CallbackInterface CloneInstance() => new ManagedCallback();
+
+        public byte GetFirstAnsiCharacter(string str) => (byte) str[0];
+
+        public char GetFirstCharacter(string str) => str[0];
+
+        public LargeStructWithMarshalling GetLargeMarshalledStruct(long a, long b, long c)
+        {
+            LargeStructWithMarshalling result = new();
+            result.I[0] = a;
+            result.I[1] = b;
+            result.I[2] = c;
+            return result;
+        }
+
+        public LargeStruct GetLargeStruct(long a, long b) => new() { A = a, B = b };
+
+        public int GetZero() => 0;
+
+        public void Increment(ref int valueRef) => valueRef += 1;
+
+        public int MappedTypeTest(uint i) => (int) i;
+
+        public IntPtr ModifyPointer(IntPtr ptr, MethodOperation op) => ptr;
+
+        public bool ArrayRelationAnd(bool[] arr) => arr.All(static x => x);
+
+        public int ArrayRelationSum(int[] arr) => arr.Sum();
+
+        public long ArrayRelationSumStruct(LargeStructWithMarshalling[] arr) => arr.Sum(static x => x.I.Sum());
+    }
+}
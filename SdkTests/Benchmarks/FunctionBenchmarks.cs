@@ -0,0 +1,60 @@
+using BenchmarkDotNet.Attributes;
+using Functions;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Calls of the generated wrappers of native functions.
+/// </summary>
+[MemoryDiagnoser]
+public class FunctionBenchmarks
+{
+    private readonly int[] ints = new int[16];
+    private readonly SimpleStruct[] structs = new SimpleStruct[16];
+    private readonly StructWithMarshal[] marshalledStructs = new StructWithMarshal[16];
+    private readonly Functions.Interface[] interfaces = new Functions.Interface[4];
+    private LargeStruct largeStruct;
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        RuntimeSetup.Initialize();
+
+        for (var i = 0; i < structs.Length; i++)
+        {
+            structs[i] = new SimpleStruct { I = i };
+            marshalledStructs[i].I[0] = i;
+        }
+
+        largeStruct = new LargeStruct();
+        largeStruct.I[0] = 10;
+        largeStruct.I[1] = 20;
+        largeStruct.I[2] = 30;
+
+        NativeFunctions.GetInterfacesWithRelation(interfaces);
+    }
+
+    [Benchmark(Baseline = true)]
+    public MyEnum Call() => NativeFunctions.PassThroughEnum(MyEnum.TestValue);
+
+    [Benchmark]
+    public long StructParameter() => NativeFunctions.SumValues(largeStruct);
+
+    [Benchmark]
+    public int StructReturn() => NativeFunctions.GetWrapper().Wrapped.I;
+
+    [Benchmark]
+    public byte StringParameter() => NativeFunctions.GetFirstAnsiCharacter("Ansi-char test");
+
+    [Benchmark]
+    public void ArrayParameter() => NativeFunctions.GetIntArray(ints.Length, ints);
+
+    [Benchmark]
+    public int RelationArrayParameter() => NativeFunctions.Sum(structs);
+
+    [Benchmark]
+    public int RelationMarshalledArrayParameter() => NativeFunctions.SumStructWithMarshal(marshalledStructs);
+
+    [Benchmark]
+    public void RelationInterfaceArrayParameter() => NativeFunctions.InInterfaceArray(interfaces);
+}
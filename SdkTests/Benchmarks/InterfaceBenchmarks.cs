@@ -0,0 +1,52 @@
+using BenchmarkDotNet.Attributes;
+using Interface;
+using SharpGen.Runtime;
+
+namespace Benchmarks;
+
+/// <summary>
+/// Calls of the generated wrappers of native interfaces.
+/// </summary>
+[MemoryDiagnoser]
+public class InterfaceBenchmarks
+{
+    private NativeInterface2 instance;
+    private NativeInterface2 other;
+    private PassThroughMethodTest passThrough;
+    private InterfaceArray<NativeInterface2> interfaces;
+
+    [GlobalSetup]
+    public void Setup()
+    {
+        RuntimeSetup.Initialize();
+
+        instance = Interface.Functions.CreateInstance();
+        other = Interface.Functions.CreateInstance();
+        passThrough = Interface.Functions.GetPassThroughMethodTest();
+        interfaces = new InterfaceArray<NativeInterface2>(other);
+    }
+
+    [GlobalCleanup]
+    public void Cleanup()
+    {
+        interfaces.Dispose();
+        passThrough.Dispose();
+        other.Dispose();
+        instance.Dispose();
+    }
+
+    [Benchmark(Baseline = true)]
+    public PointerSize VtableCall() => passThrough.PassThrough(new PointerSize(25));
+
+    [Benchmark]
+    public MyValue StructReturn() => instance.Value2;
+
+    [Benchmark]
+    public void InterfaceArrayParameter() => instance.AddToThis(interfaces, 1);
+
+    [Benchmark]
+    public void CreateAndDispose()
+    {
+        using NativeInterface2 wrapper = new(instance.NativePointer);
+    }
+}
@@ -0,0 +1,21 @@
+using System.Runtime.CompilerServices;
+using SharpGen.Runtime;
+
+namespace Benchmarks;
+
+internal static class RuntimeSetup
+{
+    /// <summary>
+    /// Measures the default runtime configuration.
+    /// </summary>
+    /// <remarks>
+    /// The SdkTests assemblies enable object tracking in their module initializers,
+    /// which are run before restoring the default.
+    /// </remarks>
+    public static void Initialize()
+    {
+        RuntimeHelpers.RunModuleConstructor(typeof(Interface.NativeInterface2).Module.ModuleHandle);
+        RuntimeHelpers.RunModuleConstructor(typeof(Functions.NativeFunctions).Module.ModuleHandle);
+        Configuration.EnableObjectTracking = false;
+    }
+}
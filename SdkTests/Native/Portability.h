@@ -0,0 +1,7 @@
+// Forced include of the GCC and Clang builds, for the MSVC specifics of the test libraries.
+#pragma once
+
+#include <cstddef>
+
+#define __stdcall
+#define __declspec(x)
@@ -0,0 +1,29 @@
+#nullable enable
+
+using System;
+using SharpGen.Logging;
+
+namespace SharpGen.Benchmarks;
+
+internal sealed class ConsoleLogger : ILogger
+{
+    public bool Verbose { get; set; }
+
+    public void Exit(string reason, int exitCode)
+    {
+        Console.Error.WriteLine(reason);
+        Environment.Exit(exitCode);
+    }
+
+    public void Log(LogLevel logLevel, LogLocation logLocation, string context, string code, string message,
+                    Exception exception, params object[] parameters)
+    {
+        if (logLevel < LogLevel.Warning && !Verbose)
+            return;
+
+        Console.Error.WriteLine(LogUtilities.FormatMessage(logLevel, logLocation, context, message, exception, parameters));
+
+        if (exception != null)
+            Console.Error.WriteLine(exception);
+    }
+}
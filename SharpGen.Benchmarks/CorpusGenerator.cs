@@ -0,0 +1,189 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace SharpGen.Benchmarks;
+
+/// <summary>
+/// Writes a synthetic C++ header corpus and its mapping configuration.
+/// </summary>
+/// <remarks>
+/// The elements are spread across the headers, each header being mapped to its own namespace.
+/// The mapping rules target single elements, like the rules of real world mappings.
+/// </remarks>
+internal sealed class CorpusGenerator
+{
+    private const string RootNamespace = "SharpGen.Corpus";
+    private const string FunctionsClass = RootNamespace + ".Part0.CorpusFunctions";
+
+    private static readonly Func<CorpusOptions, int, string?>[] RuleTemplates =
+    {
+        static (o, i) => i < o.Interfaces ? $"<map interface=\"ICorpusInterface{i}\" name=\"CorpusInterface{i}\" />" : null,
+        static (o, i) => i < o.Interfaces && o.Methods > 0
+                             ? $"<map method=\"ICorpusInterface{i}::Method{i % o.Methods}\" name=\"Invoke{i % o.Methods}\" />"
+                             : null,
+        static (o, i) => i < o.Interfaces && o.Methods > 0
+                             ? $"<map param=\"ICorpusInterface{i}::Method{i % o.Methods}::value\" attribute=\"in\" />"
+                             : null,
+        static (o, i) => i < o.Interfaces ? $"<map interface=\"ICorpusInterface{i}\" callback=\"true\" callback-dual=\"true\" />" : null,
+        static (o, i) => i < o.Structs ? $"<map struct=\"CorpusStruct{i}\" name=\"CorpusData{i}\" />" : null,
+        static (o, i) => i < o.Structs ? $"<map field=\"CorpusStruct{i}::Field\" name=\"Value\" />" : null,
+        static (o, i) => i < o.Enums ? $"<map enum=\"CorpusEnum{i}\" name=\"CorpusKind{i}\" />" : null,
+        static (o, i) => i < o.Functions ? $"<map function=\"CorpusFunction{i}\" name=\"Function{i}\" />" : null,
+    };
+
+    private readonly CorpusOptions options;
+
+    public CorpusGenerator(CorpusOptions options)
+    {
+        this.options = options ?? throw new ArgumentNullException(nameof(options));
+
+        if (options.Headers < 1)
+            throw new ArgumentOutOfRangeException(nameof(options), "At least one header is required");
+    }
+
+    /// <summary>
+    /// Writes the corpus to the directory.
+    /// </summary>
+    /// <returns>The path of the mapping configuration.</returns>
+    public string Write(DirectoryInfo directory)
+    {
+        directory.Create();
+
+        for (var part = 0; part < options.Headers; part++)
+            File.WriteAllText(Path.Combine(directory.FullName, $"Corpus{part}.h"), GenerateHeader(part));
+
+        var mappingFile = Path.Combine(directory.FullName, "Mapping.xml");
+        File.WriteAllText(mappingFile, GenerateMapping());
+        return mappingFile;
+    }
+
+    private string GenerateHeader(int part)
+    {
+        StringBuilder header = new();
+        header.AppendLine("#pragma once");
+        header.AppendLine();
+
+        for (var i = part; i < options.Macros; i += options.Headers)
+            header.AppendLine($"#define CORPUS_MACRO_{i} {i}");
+
+        for (var i = part; i < options.Enums; i += options.Headers)
+        {
+            header.AppendLine();
+            header.AppendLine($"enum CorpusEnum{i}");
+            header.AppendLine("{");
+            for (var item = 0; item < options.EnumItems; item++)
+                header.AppendLine($"    CorpusEnum{i}_Item{item} = {item},");
+            header.AppendLine("};");
+        }
+
+        for (var i = part; i < options.Structs; i += options.Headers)
+        {
+            header.AppendLine();
+            header.AppendLine($"union CorpusUnion{i}");
+            header.AppendLine("{");
+            header.AppendLine("    int Integer;");
+            header.AppendLine("    float Single;");
+            header.AppendLine("    unsigned char Bytes[4];");
+            header.AppendLine("};");
+            header.AppendLine();
+            header.AppendLine($"struct CorpusStruct{i}");
+            header.AppendLine("{");
+            header.AppendLine("    int Field;");
+            header.AppendLine($"    CorpusUnion{i} Variant;");
+            header.AppendLine("    unsigned int Flag : 1;");
+            header.AppendLine("    unsigned int Count : 15;");
+            header.AppendLine("    unsigned int Reserved : 16;");
+            if (i < options.Enums)
+                header.AppendLine($"    CorpusEnum{i} Kind;");
+            if (i >= options.Headers)
+                header.AppendLine($"    CorpusStruct{i - options.Headers} Previous;");
+            header.AppendLine("    double Values[4];");
+            header.AppendLine("};");
+        }
+
+        for (var i = part; i < options.Interfaces; i += options.Headers)
+        {
+            var data = i < options.Structs ? $"CorpusStruct{i}" : "void";
+
+            header.AppendLine();
+            header.AppendLine($"struct ICorpusInterface{i}");
+            header.AppendLine("{");
+            for (var method = 0; method < options.Methods; method++)
+            {
+                header.AppendLine(
+                    $"    virtual int __stdcall Method{method}(int value, {data}* data, const char* name, float* results, int count) = 0;"
+                );
+            }
+            header.AppendLine("};");
+        }
+
+        header.AppendLine();
+        for (var i = part; i < options.Functions; i += options.Headers)
+            header.AppendLine($"extern \"C\" int __stdcall CorpusFunction{i}(int value, float scale, const char* name);");
+
+        return header.ToString();
+    }
+
+    private string GenerateMapping()
+    {
+        StringBuilder mapping = new();
+        mapping.AppendLine("<?xml version=\"1.0\" encoding=\"utf-8\"?>");
+        mapping.AppendLine("<config id=\"Corpus\" xmlns=\"urn:SharpGen.Config\">");
+        mapping.AppendLine($"  <namespace>{RootNamespace}</namespace>");
+        mapping.AppendLine($"  <assembly>{RootNamespace}</assembly>");
+        mapping.AppendLine("  <include-dir>$(THIS_CONFIG_PATH)</include-dir>");
+
+        for (var part = 0; part < options.Headers; part++)
+            mapping.AppendLine($"  <include file=\"Corpus{part}.h\" attach=\"true\" namespace=\"{RootNamespace}.Part{part}\" />");
+
+        mapping.AppendLine("  <extension>");
+        mapping.AppendLine($"    <create class=\"{FunctionsClass}\" />");
+        mapping.AppendLine(
+            $"    <const from-macro=\"CORPUS_MACRO_(.*)\" class=\"{FunctionsClass}\" type=\"int\" name=\"Macro$1\">$1</const>"
+        );
+        mapping.AppendLine("  </extension>");
+
+        mapping.AppendLine("  <mapping>");
+        mapping.AppendLine($"    <map function=\"CorpusFunction.*\" dll='\"Corpus.dll\"' group=\"{FunctionsClass}\" />");
+        mapping.AppendLine("    <map param=\"ICorpusInterface.*::Method.*::name\" attribute=\"in\" />");
+        mapping.AppendLine("    <map param=\"ICorpusInterface.*::Method.*::results\" attribute=\"out buffer\" />");
+        mapping.AppendLine("    <map param=\"ICorpusInterface.*::Method.*::count\" relation=\"length(results)\" />");
+
+        foreach (var rule in GenerateRules())
+            mapping.Append("    ").AppendLine(rule);
+
+        mapping.AppendLine("  </mapping>");
+        mapping.AppendLine("</config>");
+        return mapping.ToString();
+    }
+
+    private IEnumerable<string> GenerateRules()
+    {
+        var emitted = 0;
+        var skipped = 0;
+
+        for (var rule = 0; emitted < options.Rules && skipped < RuleTemplates.Length; rule++)
+        {
+            var template = RuleTemplates[rule % RuleTemplates.Length];
+            var index = rule / RuleTemplates.Length % Math.Max(1, MaxElementCount);
+
+            if (template(options, index) is { } text)
+            {
+                emitted++;
+                skipped = 0;
+                yield return text;
+            }
+            else
+            {
+                skipped++;
+            }
+        }
+    }
+
+    private int MaxElementCount =>
+        Math.Max(Math.Max(options.Interfaces, options.Structs), Math.Max(options.Enums, options.Functions));
+}
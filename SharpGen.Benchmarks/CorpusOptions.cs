@@ -0,0 +1,23 @@
+#nullable enable
+
+namespace SharpGen.Benchmarks;
+
+/// <summary>
+/// Size of a synthetic header corpus.
+/// </summary>
+internal sealed class CorpusOptions
+{
+    public int Headers { get; set; } = 4;
+    public int Interfaces { get; set; } = 100;
+    public int Methods { get; set; } = 10;
+    public int Structs { get; set; } = 100;
+    public int Enums { get; set; } = 100;
+    public int EnumItems { get; set; } = 8;
+    public int Macros { get; set; } = 1000;
+    public int Functions { get; set; } = 100;
+    public int Rules { get; set; } = 2000;
+
+    public override string ToString() =>
+        $"{Headers} headers, {Interfaces} interfaces x {Methods} methods, {Structs} structs, " +
+        $"{Enums} enums x {EnumItems} items, {Macros} macros, {Functions} functions, {Rules} mapping rules";
+}
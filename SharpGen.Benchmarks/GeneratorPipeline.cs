@@ -0,0 +1,194 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using SharpGen.Config;
+using SharpGen.CppModel;
+using SharpGen.Generator;
+using SharpGen.Logging;
+using SharpGen.Model;
+using SharpGen.Parser;
+using SharpGen.Platform;
+using SharpGen.Transform;
+
+namespace SharpGen.Benchmarks;
+
+/// <summary>
+/// Runs the C++ parsing, transform and code generation phases of SharpGen, measuring each of them.
+/// </summary>
+/// <remarks>
+/// Mirrors the pipeline of the MSBuild task, without its caches: the C++ module snapshot,
+/// the CastXML include cache and the documentation providers.
+/// </remarks>
+internal sealed class GeneratorPipeline
+{
+    // The defaults of the SDK for CastXML
+    private static readonly string[] CastXmlArguments =
+    {
+        "-fmsc-version=1900", "-fms-extensions", "-fms-compatibility", "-Wno-microsoft-enum-value", "-std=c++14"
+    };
+
+    private readonly List<PhaseMeasurement> measurements = new();
+    private readonly Ioc ioc = new();
+
+    public GeneratorPipeline(ILogger logger)
+    {
+        IocServiceContainer serviceContainer = new();
+        serviceContainer.AddService(new Logger(logger));
+        serviceContainer.AddService<IDocumentationLinker, DocumentationLinker>();
+        serviceContainer.AddService<GlobalNamespaceProvider>();
+        serviceContainer.AddService(new TypeRegistry(ioc));
+        serviceContainer.AddService(new GeneratorConfig { Platforms = PlatformDetectionType.Any });
+        ioc.ConfigureServices(serviceContainer);
+        serviceContainer.AddService(new ExternalDocCommentsReader(Array.Empty<(string, IEnumerable<string>)>()));
+        serviceContainer.AddService<IGeneratorRegistry>(new DefaultGenerators(ioc));
+    }
+
+    public int TransformMaxParallelism { get; set; } = 1;
+
+    public int GeneratorMaxParallelism { get; set; } = 1;
+
+    public IReadOnlyList<PhaseMeasurement> Measurements => measurements;
+
+    public bool Run(string mappingFile, string castXmlExecutable, DirectoryInfo outputDirectory)
+    {
+        var logger = ioc.Logger;
+        var outputPath = outputDirectory.FullName;
+
+        ConfigFile config = new()
+        {
+            Files = { mappingFile },
+            Id = "SharpGen-Benchmark"
+        };
+
+        Measure("Load config", () => config.Load(null, Array.Empty<string>(), logger));
+
+        config.GetFilesWithIncludesAndExtensionHeaders(
+            out var configsWithHeaders,
+            out var configsWithExtensionHeaders
+        );
+
+        CppHeaderGenerator cppHeaderGenerator = new(outputPath, ioc);
+        var headers = Measure(
+            "Generate headers",
+            () => cppHeaderGenerator.GenerateCppHeaders(config, configsWithHeaders, configsWithExtensionHeaders)
+        );
+
+        if (logger.HasErrors)
+            return false;
+
+        IncludeDirectoryResolver resolver = new(ioc);
+        resolver.Configure(config);
+
+        CastXmlRunner castXml = new(resolver, castXmlExecutable, CastXmlArguments, ioc)
+        {
+            OutputPath = outputPath
+        };
+
+        CppParser parser = new(config, ioc)
+        {
+            OutputPath = outputPath
+        };
+
+        var module = config.CreateSkeletonModule();
+
+        MacroManager macroManager = new(castXml);
+        Measure("Preprocess macros", () => macroManager.Parse(parser.RootConfigHeaderFileName, module));
+
+        new CppExtensionHeaderGenerator().GenerateExtensionHeaders(
+            config, outputPath, module, configsWithExtensionHeaders, headers.UpdatedConfigs
+        );
+
+        if (logger.HasErrors)
+            return false;
+
+        var xmlReader = Measure("Run CastXML", () => castXml.Process(parser.RootConfigHeaderFileName));
+
+        if (logger.HasErrors)
+        {
+            xmlReader?.Dispose();
+            return false;
+        }
+
+        CppModule group;
+        using (xmlReader)
+            group = Measure("Parse CastXML output", () => parser.Run(module, xmlReader));
+
+        if (logger.HasErrors)
+            return false;
+
+        config.ExpandDynamicVariables(logger, group);
+
+        NamingRulesManager namingRules = new();
+        TransformManager transformer = new(namingRules, new ConstantManager(namingRules, ioc), ioc)
+        {
+            MaxDegreeOfParallelism = TransformMaxParallelism
+        };
+
+        var (assembly, _) = Measure("Transform", () => transformer.Transform(group, config));
+
+        if (logger.HasErrors)
+            return false;
+
+        RoslynGenerator generator = new();
+
+        if (GeneratorMaxParallelism != 1)
+        {
+            var trees = Measure("Generate code", () => generator.RunPerNamespace(assembly, ioc, GeneratorMaxParallelism));
+
+            Measure(
+                "Write generated code", () =>
+                {
+                    foreach (var (ns, tree) in trees)
+                        File.WriteAllText(Path.Combine(outputPath, $"SharpGen.Bindings.{ns ?? "Module"}.g.cs"), tree.ToString());
+                }
+            );
+        }
+        else
+        {
+            var tree = Measure("Generate code", () => generator.Run(assembly, ioc));
+
+            Measure(
+                "Write generated code",
+                () => File.WriteAllText(Path.Combine(outputPath, "SharpGen.Bindings.g.cs"), tree.ToString())
+            );
+        }
+
+        return !logger.HasErrors;
+    }
+
+    private void Measure(string phase, Action action) => Measure<object?>(
+        phase, () =>
+        {
+            action();
+            return null;
+        }
+    );
+
+    private T Measure<T>(string phase, Func<T> action)
+    {
+        var allocatedBytes = GC.GetTotalAllocatedBytes(true);
+        var stopwatch = Stopwatch.StartNew();
+
+        T result;
+        using (PhaseTrace.Begin(phase))
+            result = action();
+
+        stopwatch.Stop();
+
+        using var process = Process.GetCurrentProcess();
+        measurements.Add(
+            new PhaseMeasurement(
+                phase,
+                stopwatch.Elapsed,
+                GC.GetTotalAllocatedBytes(true) - allocatedBytes,
+                GC.GetTotalMemory(false),
+                process.PeakWorkingSet64
+            )
+        );
+
+        return result;
+    }
+}
@@ -0,0 +1,17 @@
+#nullable enable
+
+using System;
+
+namespace SharpGen.Benchmarks;
+
+/// <summary>
+/// Cost of a phase of the generator pipeline.
+/// </summary>
+/// <param name="Phase">The name of the phase.</param>
+/// <param name="Elapsed">The wall time of the phase.</param>
+/// <param name="AllocatedBytes">The bytes allocated by the process during the phase.</param>
+/// <param name="ManagedHeapBytes">The size of the managed heap at the end of the phase.</param>
+/// <param name="PeakWorkingSetBytes">The peak working set of the process at the end of the phase.</param>
+internal sealed record PhaseMeasurement(
+    string Phase, TimeSpan Elapsed, long AllocatedBytes, long ManagedHeapBytes, long PeakWorkingSetBytes
+);
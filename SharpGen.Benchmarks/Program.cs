@@ -0,0 +1,206 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using System.Text.Json;
+using SharpGen.Logging;
+
+namespace SharpGen.Benchmarks;
+
+/// <summary>
+/// Measures the generator on a synthetic header corpus.
+/// </summary>
+/// <example>
+/// <c>dotnet run -c Release --project SharpGen.Benchmarks -- --interfaces 1000 --methods 20 --rules 20000 --json results.json</c>
+/// </example>
+internal static class Program
+{
+    private const string Usage =
+        """
+        Usage: SharpGen.Benchmarks [options]
+
+        Corpus:
+          --headers <n>                  Headers, each mapped to its own namespace (default 4)
+          --interfaces <n>               Interfaces (default 100)
+          --methods <n>                  Methods per interface (default 10)
+          --structs <n>                  Structs, with a union, bitfields and a nested struct (default 100)
+          --enums <n>                    Enums (default 100)
+          --enum-items <n>               Items per enum (default 8)
+          --macros <n>                   Macros mapped to constants (default 1000)
+          --functions <n>                Functions (default 100)
+          --rules <n>                    Mapping rules targeting single elements (default 2000)
+
+        Pipeline:
+          --castxml <path>               CastXML executable (default: CastXML/bin of the repository)
+          --output <directory>           Directory of the corpus and of the generated files (default: temporary)
+          --transform-parallelism <n>    Maximum degree of parallelism of the transform (default 1)
+          --generator-parallelism <n>    Maximum degree of parallelism of the code generation (default 1)
+
+        Results:
+          --json <file>                  Writes the measurements as JSON
+          --trace <file>                 Writes a Chrome trace of the phases
+          --verbose                      Logs the messages of SharpGen
+        """;
+
+    private static int Main(string[] args)
+    {
+        CorpusOptions corpus = new();
+        ConsoleLogger logger = new();
+        string? castXml = null, output = null, json = null, trace = null;
+        int transformParallelism = 1, generatorParallelism = 1;
+
+        try
+        {
+            for (var i = 0; i < args.Length; i++)
+            {
+                string Value() => i + 1 < args.Length ? args[++i] : throw new ArgumentException($"Missing value of {args[i]}");
+                int Count() => int.Parse(Value(), NumberStyles.None, CultureInfo.InvariantCulture);
+
+                switch (args[i])
+                {
+                    case "--headers": corpus.Headers = Count(); break;
+                    case "--interfaces": corpus.Interfaces = Count(); break;
+                    case "--methods": corpus.Methods = Count(); break;
+                    case "--structs": corpus.Structs = Count(); break;
+                    case "--enums": corpus.Enums = Count(); break;
+                    case "--enum-items": corpus.EnumItems = Count(); break;
+                    case "--macros": corpus.Macros = Count(); break;
+                    case "--functions": corpus.Functions = Count(); break;
+                    case "--rules": corpus.Rules = Count(); break;
+                    case "--castxml": castXml = Value(); break;
+                    case "--output": output = Value(); break;
+                    case "--transform-parallelism": transformParallelism = Count(); break;
+                    case "--generator-parallelism": generatorParallelism = Count(); break;
+                    case "--json": json = Value(); break;
+                    case "--trace": trace = Value(); break;
+                    case "--verbose": logger.Verbose = true; break;
+                    case "--help" or "-h" or "-?":
+                        Console.WriteLine(Usage);
+                        return 0;
+                    default:
+                        throw new ArgumentException($"Unknown option {args[i]}");
+                }
+            }
+        }
+        catch (Exception e) when (e is ArgumentException or FormatException or OverflowException)
+        {
+            Console.Error.WriteLine(e.Message);
+            Console.Error.WriteLine(Usage);
+            return 1;
+        }
+
+        castXml ??= FindCastXml();
+        if (castXml == null || !File.Exists(castXml))
+        {
+            Console.Error.WriteLine("CastXML not found, use --castxml");
+            return 1;
+        }
+
+        DirectoryInfo outputDirectory = new(output ?? Path.Combine(Path.GetTempPath(), "SharpGen.Benchmarks"));
+
+        Console.WriteLine($"Corpus: {corpus}");
+        var mappingFile = new CorpusGenerator(corpus).Write(outputDirectory.CreateSubdirectory("Corpus"));
+
+        GeneratorPipeline pipeline = new(logger)
+        {
+            TransformMaxParallelism = transformParallelism,
+            GeneratorMaxParallelism = generatorParallelism
+        };
+
+        TraceRecorder? recorder = trace != null ? new TraceRecorder() : null;
+        PhaseTrace.Recorder = recorder;
+
+        var success = pipeline.Run(mappingFile, castXml, outputDirectory.CreateSubdirectory("Generated"));
+
+        PhaseTrace.Recorder = null;
+        recorder?.WriteChromeTrace(trace!);
+
+        WriteTable(pipeline.Measurements);
+
+        if (json != null)
+            WriteJson(json, corpus, pipeline.Measurements);
+
+        if (!success)
+            Console.Error.WriteLine("SharpGen reported errors, the measurements are incomplete");
+
+        return success ? 0 : 1;
+    }
+
+    private static string? FindCastXml()
+    {
+        var executable = Path.Combine(
+            "CastXML", "bin", RuntimeInformation.IsOSPlatform(OSPlatform.Windows) ? "castxml.exe" : "castxml"
+        );
+
+        for (var directory = new DirectoryInfo(Environment.CurrentDirectory); directory != null; directory = directory.Parent)
+        {
+            var path = Path.Combine(directory.FullName, executable);
+            if (File.Exists(path))
+                return path;
+        }
+
+        return null;
+    }
+
+    private static void WriteTable(IReadOnlyList<PhaseMeasurement> measurements)
+    {
+        Console.WriteLine();
+        Console.WriteLine($"{"Phase",-24} {"Time (ms)",12} {"Allocated (MB)",16} {"Heap (MB)",12} {"Peak WS (MB)",14}");
+
+        foreach (var x in measurements)
+        {
+            Console.WriteLine(
+                $"{x.Phase,-24} {x.Elapsed.TotalMilliseconds,12:F1} {ToMegabytes(x.AllocatedBytes),16:F1} " +
+                $"{ToMegabytes(x.ManagedHeapBytes),12:F1} {ToMegabytes(x.PeakWorkingSetBytes),14:F1}"
+            );
+        }
+
+        Console.WriteLine(
+            $"{"Total",-24} {measurements.Sum(static x => x.Elapsed.TotalMilliseconds),12:F1} " +
+            $"{ToMegabytes(measurements.Sum(static x => x.AllocatedBytes)),16:F1}"
+        );
+
+        static double ToMegabytes(long bytes) => bytes / (1024.0 * 1024.0);
+    }
+
+    private static void WriteJson(string path, CorpusOptions corpus, IReadOnlyList<PhaseMeasurement> measurements)
+    {
+        using var stream = File.Create(path);
+        using Utf8JsonWriter writer = new(stream, new JsonWriterOptions { Indented = true });
+
+        writer.WriteStartObject();
+        writer.WriteString("version", typeof(Ioc).Assembly.GetName().Version?.ToString());
+        writer.WriteString("runtime", RuntimeInformation.FrameworkDescription);
+
+        writer.WriteStartObject("corpus");
+        writer.WriteNumber("headers", corpus.Headers);
+        writer.WriteNumber("interfaces", corpus.Interfaces);
+        writer.WriteNumber("methods", corpus.Methods);
+        writer.WriteNumber("structs", corpus.Structs);
+        writer.WriteNumber("enums", corpus.Enums);
+        writer.WriteNumber("enumItems", corpus.EnumItems);
+        writer.WriteNumber("macros", corpus.Macros);
+        writer.WriteNumber("functions", corpus.Functions);
+        writer.WriteNumber("rules", corpus.Rules);
+        writer.WriteEndObject();
+
+        writer.WriteStartArray("phases");
+        foreach (var x in measurements)
+        {
+            writer.WriteStartObject();
+            writer.WriteString("phase", x.Phase);
+            writer.WriteNumber("milliseconds", x.Elapsed.TotalMilliseconds);
+            writer.WriteNumber("allocatedBytes", x.AllocatedBytes);
+            writer.WriteNumber("managedHeapBytes", x.ManagedHeapBytes);
+            writer.WriteNumber("peakWorkingSetBytes", x.PeakWorkingSetBytes);
+            writer.WriteEndObject();
+        }
+        writer.WriteEndArray();
+
+        writer.WriteEndObject();
+    }
+}
@@ -21,25 +21,49 @@ public sealed partial class SharpGenModuleGenerator
         List<GuidJob> guidJobs = new();
         List<VtblJob> vtblJobs = new();
         List<LinkerPreserveInterfaceJob> preserveInterfaceJobs = new();
+        List<FactoryJob> factoryJobs = new();
 
         void HandleGuid(ITypeSymbol symbol, Guid parsedGuid) =>
             guidJobs.Add(new GuidJob(symbol, parsedGuid, Utilities.GetGuidParameters(parsedGuid)));
 
-        void HandleVtbl(ITypeSymbol symbol, ITypeSymbol vtblTypeSymbol)
+        void HandleVtbl(ITypeSymbol symbol, ITypeSymbol vtblTypeSymbol, bool isForeign = false)
         {
-            bool TypePredicate(INamedTypeSymbol x) =>
-                x.AllInterfaces.Any(y => y.ToDisplayString() == CallbackableInterfaceName);
-
             Debug.Assert(!vtblJobs.Any(x => SymbolEqualityComparer.Default.Equals(x.InterfaceType, symbol)));
 
             vtblJobs.Add(
                 new VtblJob(symbol, vtblTypeSymbol)
                 {
-                    CallbackInterfaces = symbol.AllInterfaces.Where(TypePredicate).Reverse().ToArray()
+                    CallbackInterfaces = GetCallbackInterfacesInInheritanceOrder(symbol),
+                    IsForeign = isForeign
                 }
             );
         }
 
+        bool IsAccessible(ISymbol symbol) =>
+            context.Compilation.IsSymbolAccessibleWithin(symbol, context.Compilation.Assembly);
+
+        // Composes the vtables of the interfaces declared in other assemblies and implemented by the callbacks
+        // of this one, unless the declaring assembly registered them already.
+        // The Vtbl classes are internal by default, the interfaces using one are left to the reflection fallback.
+        void HandleForeignVtbls(ITypeSymbol callbackSymbol)
+        {
+            foreach (var iface in callbackSymbol.AllInterfaces)
+            {
+                if (!IsCallbackable(iface) ||
+                    vtblJobs.Any(x => SymbolEqualityComparer.Default.Equals(x.InterfaceType, iface)) ||
+                    !IsAccessible(iface) ||
+                    iface.GetVtblAttribute() is not { } vtblAttribute ||
+                    !IsAccessible(vtblAttribute))
+                    continue;
+
+                if (iface.GetGuidAttribute() is { } guidAttribute &&
+                    !guidJobs.Any(x => SymbolEqualityComparer.Default.Equals(x.Type, iface)))
+                    HandleGuid(iface, guidAttribute);
+
+                HandleVtbl(iface, vtblAttribute, true);
+            }
+        }
+
         if (context.CancellationToken.IsCancellationRequested)
             return;
 
@@ -58,6 +82,16 @@ public sealed partial class SharpGenModuleGenerator
                 preserveInterfaceJobs.Add(new LinkerPreserveInterfaceJob(symbol));
         }
 
+        // Only the wrappers requested through the generic helpers get a factory, the other ones can still be trimmed
+        foreach (var symbol in walker.RequestedWrappers.OrderBy(static x => x.ToDisplayString(), StringComparer.Ordinal))
+        {
+            if (HasWrapperConstructor(symbol, context.Compilation))
+                factoryJobs.Add(new FactoryJob(symbol));
+        }
+
+        foreach (var preserveInterfaceJob in preserveInterfaceJobs)
+            HandleForeignVtbls(preserveInterfaceJob.Type);
+
         if (context.CancellationToken.IsCancellationRequested)
             return;
 
@@ -81,13 +115,37 @@ public sealed partial class SharpGenModuleGenerator
 
         body.AddRange(guidJobs, GuidTransform);
 
+        if (context.CancellationToken.IsCancellationRequested)
+            return;
+
+        StatementSyntax FactoryTransform(FactoryJob job)
+        {
+            var typeName = ParseTypeName(job.Type.ToDisplayString());
+            var pointer = Identifier("__nativePointer");
+
+            return ExpressionStatement(
+                AssignmentExpression(
+                    SyntaxKind.SimpleAssignmentExpression,
+                    StorageField(typeName, IdentifierName("Factory")),
+                    SimpleLambdaExpression(Parameter(pointer))
+                       .WithModifiers(TokenList(Token(SyntaxKind.StaticKeyword)))
+                       .WithExpressionBody(
+                            ObjectCreationExpression(typeName)
+                               .WithArgumentList(ArgumentList(SingletonSeparatedList(Argument(IdentifierName(pointer)))))
+                        )
+                )
+            );
+        }
+
+        body.AddRange(factoryJobs, FactoryTransform);
+
         if (context.CancellationToken.IsCancellationRequested)
             return;
 
         if (vtblJobs.Count > 0)
         {
             body.AddRange(
-                vtblJobs,
+                vtblJobs.Where(x => !x.IsForeign),
                 job => ExpressionStatement(
                     AssignmentExpression(
                         SyntaxKind.SimpleAssignmentExpression,
@@ -126,12 +184,11 @@ public sealed partial class SharpGenModuleGenerator
 
                     var localVtbl = vtblJobs.ExclusiveOrDefault(
                         x => SymbolEqualityComparer.Default.Equals(x.InterfaceType, typeSymbol)
-                    )?.VtblType;
+                    )?.VtblType ?? context.Compilation.GetTypeByMetadataName(name).GetVtblAttribute();
 
-                    if (localVtbl is null &&
-                        context.Compilation.GetTypeByMetadataName(name).GetVtblAttribute() is { } vtblTypeSymbol &&
-                        context.Compilation.IsSymbolAccessibleWithin(vtblTypeSymbol, context.Compilation.Assembly))
-                        localVtbl = vtblTypeSymbol;
+                    // Read through the storage or reflection when the Vtbl class is internal to another assembly
+                    if (localVtbl is not null && !IsAccessible(localVtbl))
+                        localVtbl = null;
 
                     return ExpressionStatement(
                         InvocationExpression(
@@ -161,27 +218,47 @@ public sealed partial class SharpGenModuleGenerator
                     );
                 }
 
-                body.AddRange(vtblJob.CallbackInterfaces.Append(vtblJob.InterfaceType), AddVtbl);
+                StatementSyntaxList registration = new();
+
+                registration.AddRange(vtblJob.CallbackInterfaces.Append(vtblJob.InterfaceType), AddVtbl);
 
                 if (context.CancellationToken.IsCancellationRequested)
                     return;
 
-                body.Add(
+                var interfaceTypeArgument = TypeArgumentList(
+                    SingletonSeparatedList(ParseTypeName(vtblJob.InterfaceType.ToDisplayString()))
+                );
+
+                registration.Add(
                     ExpressionStatement(
                         InvocationExpression(
                             MemberAccessExpression(
                                 SyntaxKind.SimpleMemberAccessExpression,
                                 helper,
-                                GenericName(
-                                    Identifier("Register"),
-                                    TypeArgumentList(
-                                        SingletonSeparatedList(ParseTypeName(vtblJob.InterfaceType.ToDisplayString()))
-                                    )
-                                )
+                                GenericName(Identifier("Register"), interfaceTypeArgument)
                             )
                         )
                     )
                 );
+
+                if (vtblJob.IsForeign)
+                    body.Add(
+                        IfStatement(
+                            PrefixUnaryExpression(
+                                SyntaxKind.LogicalNotExpression,
+                                InvocationExpression(
+                                    MemberAccessExpression(
+                                        SyntaxKind.SimpleMemberAccessExpression,
+                                        TypeDataStorage,
+                                        GenericName(Identifier("IsRegistered"), interfaceTypeArgument)
+                                    )
+                                )
+                            ),
+                            registration.ToBlock()
+                        )
+                    );
+                else
+                    body.AddRange(registration);
             }
         }
 
@@ -264,12 +341,19 @@ public sealed partial class SharpGenModuleGenerator
 
     private sealed record LinkerPreserveInterfaceJob(ITypeSymbol Type);
 
+    private sealed record FactoryJob(ITypeSymbol Type);
+
     private sealed class VtblJob
     {
         public readonly ITypeSymbol InterfaceType;
         public readonly ITypeSymbol VtblType;
         public INamedTypeSymbol[]? CallbackInterfaces { get; init; }
 
+        /// <summary>
+        /// The interface is declared in another assembly, its source vtable is owned by that assembly.
+        /// </summary>
+        public bool IsForeign { get; init; }
+
         public VtblJob(ITypeSymbol interfaceType, ITypeSymbol vtblType)
         {
             InterfaceType = interfaceType ?? throw new ArgumentNullException(nameof(interfaceType));
@@ -277,6 +361,52 @@ public sealed partial class SharpGenModuleGenerator
         }
     }
 
+    /// <summary>
+    /// Checks whether <paramref name="symbol"/> is a concrete <c>CppObject</c> that the module initializer
+    /// can construct from a native pointer, like <c>MarshallingHelpers.FromPointer</c> does through reflection.
+    /// </summary>
+    private static bool HasWrapperConstructor(ITypeSymbol symbol, Compilation compilation) =>
+        symbol is INamedTypeSymbol
+        {
+            TypeKind: TypeKind.Class, IsAbstract: false, IsStatic: false, IsGenericType: false
+        } namedSymbol &&
+        symbol.HasBaseClass(CppObjectClassName) &&
+        compilation.IsSymbolAccessibleWithin(symbol, compilation.Assembly) &&
+        namedSymbol.InstanceConstructors.Any(
+            x => x.Parameters is [{ Type.SpecialType: SpecialType.System_IntPtr, RefKind: RefKind.None }] &&
+                 compilation.IsSymbolAccessibleWithin(x, compilation.Assembly)
+        );
+
+    private static bool IsCallbackable(INamedTypeSymbol symbol) =>
+        symbol.AllInterfaces.Any(y => y.ToDisplayString() == CallbackableInterfaceName);
+
+    /// <summary>
+    /// Lists the callbackable interfaces inherited by <paramref name="symbol"/> in the order of the composed vtable:
+    /// every interface comes after the interfaces it inherits, so the base vtables are laid out first.
+    /// </summary>
+    private static INamedTypeSymbol[] GetCallbackInterfacesInInheritanceOrder(ITypeSymbol symbol)
+    {
+        List<INamedTypeSymbol> result = new();
+        HashSet<INamedTypeSymbol> visited = new(SymbolEqualityComparer.Default);
+
+        void Visit(INamedTypeSymbol iface)
+        {
+            if (!visited.Add(iface))
+                return;
+
+            foreach (var baseInterface in iface.Interfaces)
+                Visit(baseInterface);
+
+            if (IsCallbackable(iface))
+                result.Add(iface);
+        }
+
+        foreach (var iface in symbol.Interfaces)
+            Visit(iface);
+
+        return result.ToArray();
+    }
+
     private static ExpressionSyntax StorageField(TypeSyntax typeName, SimpleNameSyntax name) =>
         MemberAccessExpression(
             SyntaxKind.SimpleMemberAccessExpression,
@@ -14,6 +14,10 @@ public sealed partial class SharpGenModuleGenerator : ISourceGenerator
 {
     private const string CallbackableInterfaceName = "SharpGen.Runtime.ICallbackable";
     private const string CallbackBaseClassName = "SharpGen.Runtime.CallbackBase";
+    private const string CppObjectClassName = "SharpGen.Runtime.CppObject";
+    private const string ComObjectClassName = "SharpGen.Runtime.ComObject";
+    private const string MarshallingHelpersClassName = "SharpGen.Runtime.MarshallingHelpers";
+    private const string InterfaceArrayStructName = "SharpGen.Runtime.InterfaceArray<T>";
     private const string ModuleInitializerAttributeName = "System.Runtime.CompilerServices.ModuleInitializerAttribute";
 
     private static readonly AttributeListSyntax[] ModuleInitializerAttributeList = new[]
@@ -82,6 +86,11 @@ public sealed partial class SharpGenModuleGenerator : ISourceGenerator
     {
         public readonly HashSet<ITypeSymbol> QueuedJobs = new(SymbolEqualityComparer.Default);
 
+        /// <summary>
+        /// The types the generic runtime helpers are asked to create wrappers of, see <see cref="CreatesWrappers"/>.
+        /// </summary>
+        public readonly HashSet<ITypeSymbol> RequestedWrappers = new(SymbolEqualityComparer.Default);
+
         public void OnVisitSyntaxNode(GeneratorSyntaxContext context)
         {
             var syntaxNode = context.Node;
@@ -100,6 +109,41 @@ public sealed partial class SharpGenModuleGenerator : ISourceGenerator
                         throw new ArgumentOutOfRangeException();
                 }
             }
+            else if (syntaxNode is GenericNameSyntax
+                     {
+                         Identifier.ValueText: "FromPointer" or "QueryInterface" or "QueryInterfaceOrNull"
+                                               or "InterfaceArray",
+                         TypeArgumentList.Arguments.Count: 1
+                     } genericName)
+            {
+                var symbol = context.SemanticModel.GetSymbolInfo(genericName).Symbol;
+                if (CreatesWrappers(symbol))
+                {
+                    RequestedWrappers.Add(
+                        symbol is IMethodSymbol method ? method.TypeArguments[0] : ((INamedTypeSymbol) symbol!).TypeArguments[0]
+                    );
+                }
+            }
+        }
+    }
+
+    /// <summary>
+    /// Checks whether <paramref name="symbol"/> is a generic runtime helper creating wrappers of its type argument
+    /// through <c>MarshallingHelpers.FromPointer</c>.
+    /// </summary>
+    private static bool CreatesWrappers(ISymbol? symbol)
+    {
+        switch (symbol)
+        {
+            case IMethodSymbol { TypeArguments.Length: 1, Parameters.Length: <= 1 } method:
+                while (method.OverriddenMethod is { } overridden)
+                    method = overridden;
+
+                return method.ContainingType.ToDisplayString() is MarshallingHelpersClassName or ComObjectClassName;
+            case INamedTypeSymbol { TypeArguments.Length: 1 } type:
+                return type.OriginalDefinition.ToDisplayString() == InterfaceArrayStructName;
+            default:
+                return false;
         }
     }
 }
\ No newline at end of file
@@ -0,0 +1,368 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.IO;
+using System.Xml;
+
+namespace SharpGen.Platform;
+
+/// <summary>
+/// Compact, id-indexed view of a CastXML (GCC-XML compatible) document.
+/// </summary>
+/// <remarks>
+/// The table is filled in a single forward pass over an <see cref="XmlReader"/>, without building a DOM.
+/// Elements are addressed by their row index, and the attributes are stored as parallel arrays.
+/// Only the attributes consumed by <see cref="CppParser"/> are retained.
+/// Elements referring to a context are attached to it lazily, on the first <see cref="Children"/> query.
+/// </remarks>
+internal sealed class CastXmlElementTable
+{
+    public const int NoElement = -1;
+    private const int Unresolved = -2;
+    private const int InitialCapacity = 4096;
+    private const string RootTag = "GCC_XML";
+
+    private const string AttributeId = "id";
+    private const string AttributeName = "name";
+    private const string AttributeType = "type";
+    private const string AttributeContext = "context";
+    private const string AttributeFile = "file";
+
+    /// <summary>
+    /// Attributes that are rarely present, stored in a per-row sparse list.
+    /// </summary>
+    private static readonly string[] SparseAttributes =
+    {
+        "abstract", "attributes", "bases", "bits", "incomplete", "init",
+        "inline", "max", "overrides", "pure_virtual", "returns", "size"
+    };
+
+    private readonly Dictionary<string, int> idToIndex = new();
+    private readonly Dictionary<string, List<int>> fileToElements = new(StringComparer.InvariantCultureIgnoreCase);
+
+    private string[] tags = new string[InitialCapacity];
+    private string?[] ids = new string?[InitialCapacity];
+    private string?[] names = new string?[InitialCapacity];
+    private string?[] types = new string?[InitialCapacity];
+    private string?[] contextIds = new string?[InitialCapacity];
+    private string?[] files = new string?[InitialCapacity];
+    private int[] parents = new int[InitialCapacity];
+    private KeyValuePair<string, string>[]?[] sparseAttributes = new KeyValuePair<string, string>[]?[InitialCapacity];
+
+    private int[]? contexts;
+    private int[]? firstChild;
+    private int[]? lastChild;
+    private int[]? nextSibling;
+
+    private CastXmlElementTable()
+    {
+    }
+
+    /// <summary>
+    /// Gets the number of rows (top-level and nested elements) in the table.
+    /// </summary>
+    public int Count { get; private set; }
+
+    /// <summary>
+    /// Gets the top-level elements declared in each CastXML file id, in document order.
+    /// </summary>
+    public IReadOnlyDictionary<string, List<int>> FileElements => fileToElements;
+
+    public string Tag(int index) => tags[index];
+
+    public string? Id(int index) => ids[index];
+
+    public string? Name(int index) => names[index];
+
+    public void SetName(int index, string? name) => names[index] = name;
+
+    public string? TypeId(int index) => types[index];
+
+    public string? FileId(int index) => files[index];
+
+    /// <summary>
+    /// Gets the value of an attribute of the element, or <c>null</c> if the attribute is absent or not retained.
+    /// </summary>
+    public string? Attribute(int index, string name)
+    {
+        switch (name)
+        {
+            case AttributeId:
+                return ids[index];
+            case AttributeName:
+                return names[index];
+            case AttributeType:
+                return types[index];
+            case AttributeContext:
+                return contextIds[index];
+            case AttributeFile:
+                return files[index];
+        }
+
+        if (sparseAttributes[index] is not { } attributes)
+            return null;
+
+        foreach (var attribute in attributes)
+        {
+            if (string.Equals(attribute.Key, name, StringComparison.Ordinal))
+                return attribute.Value;
+        }
+
+        return null;
+    }
+
+    /// <summary>
+    /// Gets the index of the element with the specified CastXML id.
+    /// </summary>
+    /// <exception cref="KeyNotFoundException">No element has the specified id.</exception>
+    public int this[string id] => idToIndex[id];
+
+    /// <summary>
+    /// Gets the index of the context element of the specified element, or <see cref="NoElement"/>.
+    /// </summary>
+    public int Context(int index)
+    {
+        contexts ??= CreateFilledArray(Unresolved);
+
+        var context = contexts[index];
+        if (context != Unresolved)
+            return context;
+
+        return contexts[index] = contextIds[index] is { } contextId ? idToIndex[contextId] : NoElement;
+    }
+
+    /// <summary>
+    /// Enumerates the child elements of the specified element:
+    /// the elements nested in it in the document, followed by the elements referring to it as a context.
+    /// </summary>
+    public ChildEnumerable Children(int index)
+    {
+        if (firstChild is null)
+            BuildChildLists();
+
+        return new ChildEnumerable(this, index);
+    }
+
+    private void BuildChildLists()
+    {
+        firstChild = CreateFilledArray(NoElement);
+        lastChild = CreateFilledArray(NoElement);
+        nextSibling = CreateFilledArray(NoElement);
+
+        // Physically nested elements come first, just like in the document.
+        for (var i = 0; i < Count; i++)
+        {
+            if (parents[i] != NoElement)
+                AppendChild(parents[i], i);
+        }
+
+        for (var i = 0; i < Count; i++)
+        {
+            if (contextIds[i] is not null)
+                AppendChild(Context(i), i);
+        }
+    }
+
+    private void AppendChild(int parent, int child)
+    {
+        Debug.Assert(firstChild != null && lastChild != null && nextSibling != null);
+
+        var last = lastChild![parent];
+        if (last != NoElement)
+            nextSibling![last] = child;
+        else
+            firstChild![parent] = child;
+
+        lastChild[parent] = child;
+    }
+
+    private int[] CreateFilledArray(int value)
+    {
+        var array = new int[Count];
+
+#if NETCOREAPP2_0_OR_GREATER
+        Array.Fill(array, value);
+#else
+        for (var i = 0; i < array.Length; i++)
+            array[i] = value;
+#endif
+
+        return array;
+    }
+
+    /// <summary>
+    /// Reads a CastXML document into a new table.
+    /// </summary>
+    /// <param name="reader">The reader over the CastXML output.</param>
+    public static CastXmlElementTable Load(TextReader reader)
+    {
+        var settings = new XmlReaderSettings
+        {
+            DtdProcessing = DtdProcessing.Ignore,
+            IgnoreComments = true,
+            IgnoreProcessingInstructions = true,
+            IgnoreWhitespace = true
+        };
+
+        using var xmlReader = XmlReader.Create(reader, settings);
+
+        var table = new CastXmlElementTable();
+        table.Fill(xmlReader);
+        return table;
+    }
+
+    private void Fill(XmlReader reader)
+    {
+        var nameTable = reader.NameTable;
+        var rootTag = nameTable.Add(RootTag);
+        var idAttribute = nameTable.Add(AttributeId);
+        var nameAttribute = nameTable.Add(AttributeName);
+        var typeAttribute = nameTable.Add(AttributeType);
+        var contextAttribute = nameTable.Add(AttributeContext);
+        var fileAttribute = nameTable.Add(AttributeFile);
+
+        var sparseAttributeNames = new HashSet<string>(StringComparer.Ordinal);
+        foreach (var attribute in SparseAttributes)
+            sparseAttributeNames.Add(nameTable.Add(attribute));
+
+        var sparseBuffer = new List<KeyValuePair<string, string>>();
+
+        // Stack of open elements, used to link nested elements (Argument, EnumValue) to their declarations.
+        var openElements = new Stack<int>();
+        var insideRoot = false;
+
+        while (reader.Read())
+        {
+            if (reader.NodeType == XmlNodeType.EndElement)
+            {
+                if (openElements.Count != 0)
+                    openElements.Pop();
+                else if (ReferenceEquals(reader.LocalName, rootTag))
+                    insideRoot = false;
+
+                continue;
+            }
+
+            if (reader.NodeType != XmlNodeType.Element)
+                continue;
+
+            if (!insideRoot)
+            {
+                insideRoot = ReferenceEquals(reader.LocalName, rootTag) && !reader.IsEmptyElement;
+                continue;
+            }
+
+            var index = Count;
+            EnsureCapacity(index + 1);
+            Count = index + 1;
+
+            tags[index] = reader.LocalName;
+            parents[index] = openElements.Count != 0 ? openElements.Peek() : NoElement;
+
+            sparseBuffer.Clear();
+
+            if (reader.MoveToFirstAttribute())
+            {
+                do
+                {
+                    var attributeName = reader.LocalName;
+
+                    // Ids are repeated many times across the document, atomize them to share the instances.
+                    if (ReferenceEquals(attributeName, idAttribute))
+                        ids[index] = nameTable.Add(reader.Value);
+                    else if (ReferenceEquals(attributeName, nameAttribute))
+                        names[index] = reader.Value;
+                    else if (ReferenceEquals(attributeName, typeAttribute))
+                        types[index] = nameTable.Add(reader.Value);
+                    else if (ReferenceEquals(attributeName, contextAttribute))
+                        contextIds[index] = nameTable.Add(reader.Value);
+                    else if (ReferenceEquals(attributeName, fileAttribute))
+                        files[index] = nameTable.Add(reader.Value);
+                    else if (sparseAttributeNames.Contains(attributeName))
+                        sparseBuffer.Add(new KeyValuePair<string, string>(attributeName, reader.Value));
+                } while (reader.MoveToNextAttribute());
+
+                reader.MoveToElement();
+            }
+
+            if (sparseBuffer.Count != 0)
+                sparseAttributes[index] = sparseBuffer.ToArray();
+
+            // Only top-level declarations are addressable by id and by file.
+            if (parents[index] == NoElement)
+            {
+                if (ids[index] is { } id)
+                    idToIndex.Add(id, index);
+
+                if (files[index] is { } file)
+                {
+                    if (!fileToElements.TryGetValue(file, out var elementsInFile))
+                    {
+                        elementsInFile = new List<int>();
+                        fileToElements.Add(file, elementsInFile);
+                    }
+
+                    elementsInFile.Add(index);
+                }
+            }
+
+            if (!reader.IsEmptyElement)
+                openElements.Push(index);
+        }
+    }
+
+    private void EnsureCapacity(int capacity)
+    {
+        if (capacity <= tags.Length)
+            return;
+
+        var newCapacity = Math.Max(capacity, tags.Length * 2);
+
+        Array.Resize(ref tags, newCapacity);
+        Array.Resize(ref ids, newCapacity);
+        Array.Resize(ref names, newCapacity);
+        Array.Resize(ref types, newCapacity);
+        Array.Resize(ref contextIds, newCapacity);
+        Array.Resize(ref files, newCapacity);
+        Array.Resize(ref parents, newCapacity);
+        Array.Resize(ref sparseAttributes, newCapacity);
+    }
+
+    public readonly struct ChildEnumerable
+    {
+        private readonly CastXmlElementTable table;
+        private readonly int parent;
+
+        public ChildEnumerable(CastXmlElementTable table, int parent)
+        {
+            this.table = table;
+            this.parent = parent;
+        }
+
+        public ChildEnumerator GetEnumerator() => new(table, parent);
+    }
+
+    public struct ChildEnumerator
+    {
+        private readonly CastXmlElementTable table;
+        private readonly int parent;
+        private int current;
+
+        public ChildEnumerator(CastXmlElementTable table, int parent)
+        {
+            this.table = table;
+            this.parent = parent;
+            current = Unresolved;
+        }
+
+        public int Current => current;
+
+        public bool MoveNext()
+        {
+            current = current == Unresolved ? table.firstChild![parent] : table.nextSibling![current];
+            return current != NoElement;
+        }
+    }
+}
@@ -23,7 +23,9 @@ using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
 using System.Linq;
+using System.Text;
 using System.Text.RegularExpressions;
+using System.Threading.Tasks;
 using SharpGen.Logging;
 using SharpGen.Parser;
 
@@ -40,16 +42,48 @@ public sealed class CastXmlRunner : ICastXmlRunner
     // path/to/header.h:68:1: error:
     private static readonly Regex MatchFileErrorRegex = new(@"^(.*):(\d+):(\d+):\s+error:(.*)", RegexOptions.Compiled);
 
+    // # 1 "path/to/header.h" 1
+    private static readonly Regex MatchLineMarker = new(@"^\s*#\s+\d+\s+""([^""]+)""", RegexOptions.Compiled);
+
     private IReadOnlyList<string> AdditionalArguments { get; }
 
     public string OutputPath { get; set; }
 
+    /// <summary>
+    /// Gets or sets the precompiled header included by the XML runs of <see cref="Process(string)"/>.
+    /// </summary>
+    /// <remarks>
+    /// The header is built by <see cref="GeneratePrecompiledHeader"/>. It isn't used for preprocessing,
+    /// the macros it defines wouldn't be part of the preprocessed output.
+    /// </remarks>
+    public string PrecompiledHeader { get; set; }
+
+    /// <summary>
+    /// Gets whether the last XML run rejected the <see cref="PrecompiledHeader"/> and ran again without it.
+    /// </summary>
+    public bool PrecompiledHeaderRejected { get; private set; }
+
     /// <summary>
     /// Gets or sets the executable path of castxml.
     /// </summary>
     /// <value>The executable path.</value>
     private string ExecutablePath { get; }
 
+    /// <summary>
+    /// Gets a key identifying the castxml command line: any change to it can change the parsed module.
+    /// </summary>
+    public string ConfigurationKey
+    {
+        get
+        {
+            StringBuilder key = new();
+            key.AppendLine(ExecutablePath);
+            key.AppendLine(string.Join(" ", GetCastXmlArgs()));
+            key.AppendLine(string.Join(" ", directoryResolver.IncludeArguments));
+            return key.ToString();
+        }
+    }
+
     private Logger Logger => ioc.Logger;
 
     private readonly IncludeDirectoryResolver directoryResolver;
@@ -85,6 +119,136 @@ public sealed class CastXmlRunner : ICastXmlRunner
         });
     }
 
+    /// <summary>
+    /// Preprocesses the specified header file and keeps the preprocessed translation unit,
+    /// so that it can be processed without running the preprocessor again.
+    /// </summary>
+    /// <param name="headerFile">The header file.</param>
+    /// <param name="preprocessedFile">The file receiving the preprocessed translation unit.</param>
+    /// <param name="handler">The handler.</param>
+    /// <remarks>
+    /// The headers are preprocessed with <see cref="CppHeaderGenerator.PreprocessOnlyMacro"/> defined.
+    /// Macros predefined by the compiler or from the command line are not written to <paramref name="preprocessedFile"/>,
+    /// the translation unit is included by a regular header that already defines them.
+    /// </remarks>
+    public void Preprocess(string headerFile, string preprocessedFile, CastXmlPreprocessedLineReceivedEventHandler handler)
+    {
+        Logger.RunInContext(nameof(Preprocess), () =>
+        {
+            if (!File.Exists(ExecutablePath))
+                Logger.Fatal("castxml not found from path: [{0}]", ExecutablePath);
+
+            if (!File.Exists(headerFile))
+                Logger.Fatal("C++ Header file [{0}] not found", headerFile);
+
+            using var currentProcess = CreateCastXmlProcess(
+                headerFile, $"-E -dD -D{CppHeaderGenerator.PreprocessOnlyMacro}"
+            );
+            currentProcess.ErrorDataReceived += ProcessErrorFromHeaderFile;
+            currentProcess.Start();
+            currentProcess.BeginErrorReadLine();
+
+            // Read the output on this thread rather than through an event per line
+            using (var writer = new StreamWriter(preprocessedFile, false))
+            {
+                var isSpecialFile = false;
+                string line;
+                while ((line = currentProcess.StandardOutput.ReadLine()) != null)
+                {
+                    handler(line);
+
+                    // Keep the line markers balanced, drop the contents of <built-in> and <command line>
+                    var matchLineMarker = MatchLineMarker.Match(line);
+                    if (matchLineMarker.Success)
+                        isSpecialFile = matchLineMarker.Groups[1].Value.StartsWith("<");
+                    else if (isSpecialFile)
+                        continue;
+
+                    writer.WriteLine(line);
+                }
+            }
+
+            currentProcess.WaitForExit();
+
+            if (Logger.HasErrors)
+            {
+                File.Delete(preprocessedFile);
+                Logger.Error(LoggingCodes.CastXmlFailed, "Failed to run CastXML. Check previous errors.");
+            }
+        });
+    }
+
+    /// <summary>
+    /// Builds a clang precompiled header, with the same options as the XML runs.
+    /// </summary>
+    /// <param name="headerFile">The header to precompile.</param>
+    /// <param name="precompiledHeaderFile">The precompiled header to write.</param>
+    /// <param name="dependencyFile">The file receiving the headers the precompiled header depends on, in the Makefile format.</param>
+    /// <returns><c>true</c> if the precompiled header was built.</returns>
+    /// <remarks>
+    /// A failure is only reported as a warning, the headers can still be parsed without the precompiled header.
+    /// </remarks>
+    public bool GeneratePrecompiledHeader(string headerFile, string precompiledHeaderFile, string dependencyFile)
+    {
+        var success = false;
+
+        Logger.RunInContext(nameof(GeneratePrecompiledHeader), () =>
+        {
+            if (!File.Exists(ExecutablePath)) Logger.Fatal("castxml not found from path: [{0}]", ExecutablePath);
+
+            if (!File.Exists(headerFile)) Logger.Fatal("C++ Header file [{0}] not found", headerFile);
+
+            File.Delete(precompiledHeaderFile);
+            File.Delete(dependencyFile);
+
+            // Without the castxml output option, castxml runs the clang front end action selected by the arguments
+            var arguments = AdditionalArguments.Concat(ClangArguments)
+                                               .Append("-x c++-header")
+                                               .Append($"-MD -MF \"{dependencyFile}\"")
+                                               .Append($"-o \"{precompiledHeaderFile}\"");
+
+            List<string> output = new();
+            int exitCode;
+
+            using (var process = CreateCastXmlProcess(headerFile, arguments))
+            {
+                void Receive(object sender, DataReceivedEventArgs e)
+                {
+                    if (e.Data == null)
+                        return;
+
+                    lock (output)
+                        output.Add(e.Data);
+                }
+
+                process.ErrorDataReceived += Receive;
+                process.OutputDataReceived += Receive;
+                process.Start();
+                process.BeginOutputReadLine();
+                process.BeginErrorReadLine();
+                process.WaitForExit();
+                exitCode = process.ExitCode;
+            }
+
+            foreach (var line in output)
+                Logger.Message(line);
+
+            success = exitCode == 0 && File.Exists(precompiledHeaderFile);
+
+            if (!success)
+            {
+                File.Delete(precompiledHeaderFile);
+                Logger.Warning(
+                    LoggingCodes.CastXmlWarning,
+                    "Unable to precompile [{0}] with castxml, the headers are parsed without a precompiled header.",
+                    headerFile
+                );
+            }
+        });
+
+        return success;
+    }
+
     /// <summary>
     /// Processes the specified header headerFile.
     /// </summary>
@@ -93,6 +257,7 @@ public sealed class CastXmlRunner : ICastXmlRunner
     public StreamReader Process(string headerFile)
     {
         StreamReader result = null;
+        PrecompiledHeaderRejected = false;
 
         Logger.RunInContext(nameof(Process), () =>
         {
@@ -105,6 +270,18 @@ public sealed class CastXmlRunner : ICastXmlRunner
             // Delete any previously generated xml file
             File.Delete(xmlFile);
 
+            if (PrecompiledHeader != null && File.Exists(PrecompiledHeader))
+            {
+                if (TryProcessWithPrecompiledHeader(headerFile, xmlFile))
+                {
+                    result = File.OpenText(xmlFile);
+                    return;
+                }
+
+                PrecompiledHeaderRejected = true;
+                File.Delete(xmlFile);
+            }
+
             RunCastXml(headerFile, LogCastXmlOutput, $"-o \"{xmlFile}\"");
 
             if (!File.Exists(xmlFile) || Logger.HasErrors)
@@ -120,25 +297,163 @@ public sealed class CastXmlRunner : ICastXmlRunner
         return result;
     }
 
-    private void RunCastXml(string headerFile, DataReceivedEventHandler outputDataCallback, string additionalArguments)
+    /// <summary>
+    /// Processes the specified header files with concurrent CastXML processes.
+    /// </summary>
+    /// <param name="headerFiles">The header files.</param>
+    /// <param name="maxDegreeOfParallelism">The maximum number of concurrent CastXML processes.</param>
+    /// <returns>The readers over the XML outputs, in the order of <paramref name="headerFiles"/>.
+    /// An item is <c>null</c> if CastXML failed on the corresponding header.</returns>
+    public StreamReader[] Process(IReadOnlyList<string> headerFiles, int maxDegreeOfParallelism)
     {
-        var arguments = GetCastXmlArgs().Append(additionalArguments)
-                                        .Concat(directoryResolver.IncludeArguments);
-        var argumentsString = string.Join(" ", arguments);
+        var results = new StreamReader[headerFiles.Count];
 
-        Logger.Message("CastXML {0}", argumentsString);
-        using var currentProcess = new Process
+        Logger.RunInContext(nameof(Process), () =>
         {
-            StartInfo = new ProcessStartInfo(ExecutablePath)
+            if (!File.Exists(ExecutablePath)) Logger.Fatal("castxml not found from path: [{0}]", ExecutablePath);
+
+            var xmlFiles = new string[headerFiles.Count];
+            var processes = new Process[headerFiles.Count];
+            var outputs = new List<(bool IsError, string Line)>[headerFiles.Count];
+            var exitCodes = new int[headerFiles.Count];
+
+            try
             {
-                RedirectStandardOutput = true,
-                RedirectStandardError = true,
-                UseShellExecute = false,
-                CreateNoWindow = true,
-                WorkingDirectory = OutputPath,
-                Arguments = $"{argumentsString} \"{headerFile}\""
+                for (var i = 0; i < headerFiles.Count; i++)
+                {
+                    if (!File.Exists(headerFiles[i])) Logger.Fatal("C++ Header file [{0}] not found", headerFiles[i]);
+
+                    xmlFiles[i] = Path.ChangeExtension(headerFiles[i], "xml");
+
+                    // Delete any previously generated xml file
+                    File.Delete(xmlFiles[i]);
+
+                    processes[i] = CreateCastXmlProcess(headerFiles[i], $"-o \"{xmlFiles[i]}\"");
+                    outputs[i] = new List<(bool IsError, string Line)>();
+                }
+
+                // The logger is not thread-safe: buffer the output of each process and replay it afterwards
+                Parallel.For(
+                    0, processes.Length,
+                    new ParallelOptions { MaxDegreeOfParallelism = maxDegreeOfParallelism },
+                    i =>
+                    {
+                        var process = processes[i];
+                        var output = outputs[i];
+
+                        void Receive(bool isError, string line)
+                        {
+                            if (line == null)
+                                return;
+
+                            lock (output)
+                                output.Add((isError, line));
+                        }
+
+                        process.ErrorDataReceived += (_, e) => Receive(true, e.Data);
+                        process.OutputDataReceived += (_, e) => Receive(false, e.Data);
+                        process.Start();
+                        process.BeginOutputReadLine();
+                        process.BeginErrorReadLine();
+                        process.WaitForExit();
+                        exitCodes[i] = process.ExitCode;
+                    }
+                );
             }
-        };
+            finally
+            {
+                foreach (var process in processes)
+                    process?.Dispose();
+            }
+
+            for (var i = 0; i < headerFiles.Count; i++)
+            {
+                foreach (var (isError, line) in outputs[i])
+                {
+                    if (isError)
+                        LogCastXmlError(line);
+                    else
+                        Logger.Message(line);
+                }
+
+                // The errors of the other processes don't invalidate the output of this one
+                var failed = exitCodes[i] != 0 || outputs[i].Any(static x => x.IsError && MatchError.IsMatch(x.Line));
+
+                if (!File.Exists(xmlFiles[i]) || failed)
+                {
+                    Logger.Error(LoggingCodes.CastXmlFailed, "Unable to generate XML file with castxml [{0}]. Check previous errors.", xmlFiles[i]);
+                }
+                else
+                {
+                    results[i] = File.OpenText(xmlFiles[i]);
+                }
+            }
+        });
+
+        return results;
+    }
+
+    /// <summary>
+    /// Runs CastXML with the <see cref="PrecompiledHeader"/>, its output is only logged when it succeeds.
+    /// </summary>
+    /// <remarks>
+    /// Clang rejects a precompiled header built by another version or with other options,
+    /// the caller then runs CastXML again without it.
+    /// </remarks>
+    private bool TryProcessWithPrecompiledHeader(string headerFile, string xmlFile)
+    {
+        List<(bool IsError, string Line)> output = new();
+        int exitCode;
+
+        using (var process = CreateCastXmlProcess(
+                   headerFile, $"-include-pch \"{PrecompiledHeader}\" -o \"{xmlFile}\""
+               ))
+        {
+            void Receive(bool isError, string line)
+            {
+                if (line == null)
+                    return;
+
+                lock (output)
+                    output.Add((isError, line));
+            }
+
+            process.ErrorDataReceived += (_, e) => Receive(true, e.Data);
+            process.OutputDataReceived += (_, e) => Receive(false, e.Data);
+            process.Start();
+            process.BeginOutputReadLine();
+            process.BeginErrorReadLine();
+            process.WaitForExit();
+            exitCode = process.ExitCode;
+        }
+
+        if (exitCode != 0 || !File.Exists(xmlFile) || output.Any(static x => x.IsError && MatchError.IsMatch(x.Line)))
+        {
+            foreach (var (_, line) in output)
+                Logger.Message(line);
+
+            Logger.Warning(
+                LoggingCodes.CastXmlWarning,
+                "castxml failed with the precompiled header [{0}], parsing [{1}] without it.",
+                PrecompiledHeader, headerFile
+            );
+            return false;
+        }
+
+        foreach (var (isError, line) in output)
+        {
+            if (isError)
+                LogCastXmlError(line);
+            else
+                Logger.Message(line);
+        }
+
+        return true;
+    }
+
+    private void RunCastXml(string headerFile, DataReceivedEventHandler outputDataCallback, string additionalArguments)
+    {
+        using var currentProcess = CreateCastXmlProcess(headerFile, additionalArguments);
         currentProcess.ErrorDataReceived += ProcessErrorFromHeaderFile;
         currentProcess.OutputDataReceived += outputDataCallback;
         currentProcess.Start();
@@ -153,14 +468,41 @@ public sealed class CastXmlRunner : ICastXmlRunner
         }
     }
 
+    private Process CreateCastXmlProcess(string headerFile, string additionalArguments) =>
+        CreateCastXmlProcess(headerFile, GetCastXmlArgs().Append(additionalArguments));
+
+    private Process CreateCastXmlProcess(string headerFile, IEnumerable<string> arguments)
+    {
+        var argumentsString = string.Join(" ", arguments.Concat(directoryResolver.IncludeArguments));
+
+        Logger.Message("CastXML {0}", argumentsString);
+        return new Process
+        {
+            StartInfo = new ProcessStartInfo(ExecutablePath)
+            {
+                RedirectStandardOutput = true,
+                RedirectStandardError = true,
+                UseShellExecute = false,
+                CreateNoWindow = true,
+                WorkingDirectory = OutputPath,
+                Arguments = $"{argumentsString} \"{headerFile}\""
+            }
+        };
+    }
+
+    private static readonly string[] ClangArguments =
+    {
+        "-m32",
+        "-x c++",
+        "-Wmacro-redefined",
+        "-Wno-invalid-token-paste",
+        "-Wno-ignored-attributes"
+    };
+
     private IEnumerable<string> GetCastXmlArgs()
     {
         return AdditionalArguments.Append("--castxml-gccxml")
-                                  .Append("-m32")
-                                  .Append("-x c++")
-                                  .Append("-Wmacro-redefined")
-                                  .Append("-Wno-invalid-token-paste")
-                                  .Append("-Wno-ignored-attributes");
+                                  .Concat(ClangArguments);
     }
 
     /// <summary>
@@ -169,28 +511,31 @@ public sealed class CastXmlRunner : ICastXmlRunner
     /// <param name="sender">The sender.</param>
     /// <param name="e">The <see cref="System.Diagnostics.DataReceivedEventArgs"/> instance containing the event data.</param>
     private void ProcessErrorFromHeaderFile(object sender, DataReceivedEventArgs e)
+    {
+        if (e.Data != null)
+            LogCastXmlError(e.Data);
+    }
+
+    private void LogCastXmlError(string data)
     {
         var popContext = false;
         try
         {
-            if (e.Data != null)
-            {
-                var matchError = MatchFileErrorRegex.Match(e.Data);
+            var matchError = MatchFileErrorRegex.Match(data);
 
-                var errorText = e.Data;
-
-                if (matchError.Success)
-                {
-                    Logger.PushLocation(matchError.Groups[1].Value, int.Parse(matchError.Groups[2].Value), int.Parse(matchError.Groups[3].Value));
-                    popContext = true;
-                    errorText = matchError.Groups[4].Value;
-                }
+            var errorText = data;
 
-                if (MatchError.Match(e.Data).Success)
-                    Logger.Error(LoggingCodes.CastXmlError, errorText);
-                else
-                    Logger.Warning(LoggingCodes.CastXmlWarning, errorText);
+            if (matchError.Success)
+            {
+                Logger.PushLocation(matchError.Groups[1].Value, int.Parse(matchError.Groups[2].Value), int.Parse(matchError.Groups[3].Value));
+                popContext = true;
+                errorText = matchError.Groups[4].Value;
             }
+
+            if (MatchError.Match(data).Success)
+                Logger.Error(LoggingCodes.CastXmlError, errorText);
+            else
+                Logger.Warning(LoggingCodes.CastXmlWarning, errorText);
         }
         finally
         {
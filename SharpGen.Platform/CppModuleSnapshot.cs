@@ -0,0 +1,173 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using SharpGen.CppModel;
+using SharpGen.Logging;
+
+namespace SharpGen.Platform;
+
+/// <summary>
+/// Binary snapshot of the parsed <see cref="CppModule"/>, reloaded instead of running CastXML
+/// and <see cref="CppParser"/> when none of the parser inputs changed.
+/// </summary>
+/// <remarks>
+/// The snapshot records the content hash of every input file (headers read by the preprocessor,
+/// generated headers and CastXML itself) and a key of the configuration the module was parsed with.
+/// It must be saved right after parsing, before the module is mutated by the mapping rules.
+/// </remarks>
+public sealed class CppModuleSnapshot
+{
+    private const int FormatSignature = ('S' << 0) | ('G' << 8) | ('C' << 16) | ('M' << 24);
+    private const int FormatVersion = 1;
+
+    private readonly string path;
+    private readonly string configurationKey;
+    private readonly FileHashCache fileHashes = new();
+    private readonly Ioc ioc;
+
+    /// <summary>
+    /// Initializes a new instance of the <see cref="CppModuleSnapshot"/> class.
+    /// </summary>
+    /// <param name="path">The snapshot file path.</param>
+    /// <param name="configurationKey">The key of the parser configuration.</param>
+    /// <param name="ioc">The service container.</param>
+    public CppModuleSnapshot(string path, string configurationKey, Ioc ioc)
+    {
+        this.path = path ?? throw new ArgumentNullException(nameof(path));
+        this.ioc = ioc ?? throw new ArgumentNullException(nameof(ioc));
+        this.configurationKey = FileHashCache.ComputeHash(
+            Encoding.UTF8.GetBytes(configurationKey ?? throw new ArgumentNullException(nameof(configurationKey)))
+        );
+    }
+
+    private Logger Logger => ioc.Logger;
+
+    /// <summary>
+    /// Gets the header files read by the preprocessor when the loaded module was parsed.
+    /// </summary>
+    public IReadOnlyList<string> IncludedFiles { get; private set; } = Array.Empty<string>();
+
+    /// <summary>
+    /// Loads the module snapshot, if it exists and all its inputs are unchanged.
+    /// </summary>
+    /// <returns>The parsed module, or <c>null</c> if the module needs to be parsed again.</returns>
+    public CppModule? TryLoad()
+    {
+        if (!File.Exists(path))
+            return null;
+
+        try
+        {
+            using CppModelReader reader = new(File.OpenRead(path));
+
+            if (reader.ReadInt() != FormatSignature || reader.ReadInt() != FormatVersion)
+            {
+                Logger.Message("C++ module snapshot format changed.");
+                return null;
+            }
+
+            if (reader.ReadString() != configurationKey)
+            {
+                Logger.Message("C++ parser configuration changed.");
+                return null;
+            }
+
+            for (int i = 0, count = reader.ReadInt(); i < count; i++)
+            {
+                var input = reader.ReadString()!;
+                var hash = reader.ReadString();
+
+                if (fileHashes.GetHash(input) != hash)
+                {
+                    Logger.Message("C++ parser input [{0}] changed.", input);
+                    return null;
+                }
+            }
+
+            var includedFileCount = reader.ReadInt();
+            List<string> includedFiles = new(includedFileCount);
+            for (var i = 0; i < includedFileCount; i++)
+                includedFiles.Add(reader.ReadString()!);
+
+            var module = (CppModule) reader.ReadElement();
+            IncludedFiles = includedFiles;
+            return module;
+        }
+        catch (Exception e) when (e is IOException or InvalidDataException or InvalidCastException
+                                      or ArgumentException or UnauthorizedAccessException)
+        {
+            Logger.Message("Ignoring the unreadable C++ module snapshot [{0}]: {1}", path, e.Message);
+            return null;
+        }
+    }
+
+    /// <summary>
+    /// Saves the module snapshot.
+    /// </summary>
+    /// <param name="module">The module, as produced by <see cref="CppParser"/>.</param>
+    /// <param name="inputs">All the files the parsed module depends on.</param>
+    /// <param name="includedFiles">The header files read by the preprocessor.</param>
+    public void Save(CppModule module, IEnumerable<string> inputs, IEnumerable<string> includedFiles)
+    {
+        var includedFileList = includedFiles.ToList();
+        List<(string Path, string Hash)> inputHashes = new();
+
+        foreach (var input in inputs.Concat(includedFileList).Distinct(StringComparer.InvariantCultureIgnoreCase))
+        {
+            if (fileHashes.GetHash(input) is not { } hash)
+            {
+                // A missing input can't be validated on the next run, don't keep a stale snapshot around.
+                Logger.Message("C++ parser input [{0}] is not readable, skipping the C++ module snapshot.", input);
+                Delete();
+                return;
+            }
+
+            inputHashes.Add((input, hash));
+        }
+
+        try
+        {
+            using CppModelWriter writer = new(File.Create(path));
+            writer.WriteInt(FormatSignature);
+            writer.WriteInt(FormatVersion);
+            writer.WriteString(configurationKey);
+
+            writer.WriteInt(inputHashes.Count);
+            foreach (var (input, hash) in inputHashes)
+            {
+                writer.WriteString(input);
+                writer.WriteString(hash);
+            }
+
+            writer.WriteInt(includedFileList.Count);
+            foreach (var includedFile in includedFileList)
+                writer.WriteString(includedFile);
+
+            writer.WriteElement(module);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            Logger.Message("Unable to write the C++ module snapshot [{0}]: {1}", path, e.Message);
+            Delete();
+        }
+    }
+
+    /// <summary>
+    /// Deletes the module snapshot, forcing the next run to parse the headers.
+    /// </summary>
+    public void Delete()
+    {
+        try
+        {
+            File.Delete(path);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            Logger.Message("Unable to delete the C++ module snapshot [{0}]: {1}", path, e.Message);
+        }
+    }
+}
@@ -26,7 +26,6 @@ using System.Linq;
 using System.Runtime.InteropServices;
 using System.Text;
 using System.Text.RegularExpressions;
-using System.Xml.Linq;
 using SharpGen.Config;
 using SharpGen.CppModel;
 using SharpGen.Logging;
@@ -34,17 +33,6 @@ using SharpGen.Parser;
 
 namespace SharpGen.Platform;
 
-internal static class Extension
-{
-    /// <summary>
-    /// Get the value from an attribute.
-    /// </summary>
-    /// <param name="xElement">The <see cref="XElement"/> object to get the attribute from.</param>
-    /// <param name="name">The name of the attribute.</param>
-    /// <returns></returns>
-    public static string AttributeValue(this XElement xElement, string name) => xElement.Attribute(name)?.Value;
-}
-
 /// <summary>
 /// Full C++ Parser built on top of <see cref="CastXmlRunner"/>.
 /// </summary>
@@ -57,9 +45,12 @@ public sealed class CppParser
     private readonly HashSet<string> _boundTypes = new();
     private readonly ConfigFile _configRoot;
     private CppInclude _currentCppInclude;
-    private readonly Dictionary<string, XElement> _mapIdToXElement = new();
-    private readonly Dictionary<string, List<XElement>> _mapFileToXElement = new(StringComparer.InvariantCultureIgnoreCase);
+    private CastXmlElementTable _elements;
+    private CppElement[] _parsedElements;
+    private readonly Dictionary<string, string> _mapFileIdToIncludeId = new();
     private readonly Dictionary<string, int> _mapIncludeToAnonymousEnumCount = new(StringComparer.InvariantCultureIgnoreCase);
+    private readonly Dictionary<string, StringBuilder> _includeRuleKeys = new(StringComparer.InvariantCultureIgnoreCase);
+    private string _configurationKey;
     private readonly Ioc ioc;
 
     public CppParser(ConfigFile configRoot, Ioc ioc)
@@ -84,6 +75,7 @@ public sealed class CppParser
             {
                 var includeRuleId = includeRule.Id;
                 _includeToProcess.Add(includeRuleId);
+                AppendIncludeRuleKey(includeRule);
 
                 // Handle attach types
                 // Set that the include is attached (so that all types inside are attached
@@ -124,29 +116,93 @@ public sealed class CppParser
                     _includeIsAttached.Add(configFile.ExtensionId, true);
             }
         }
+
+        _configurationKey = ComputeConfigurationKey();
+    }
+
+    private void AppendIncludeRuleKey(IncludeRule includeRule)
+    {
+        if (!_includeRuleKeys.TryGetValue(includeRule.Id, out var key))
+        {
+            key = new StringBuilder();
+            _includeRuleKeys.Add(includeRule.Id, key);
+        }
+
+        key.Append(includeRule.File).Append('|')
+           .Append(includeRule.Attach).Append('|')
+           .Append(includeRule.Pre).Append('|')
+           .Append(includeRule.Post).Append('|')
+           .Append(string.Join(",", includeRule.AttachTypes))
+           .Append('\n');
     }
 
     /// <summary>
-    /// Gets the name of the generated GCCXML file.
+    /// Computes the part of the <see cref="ConfigurationKey"/> shared by all includes:
+    /// the parser version, the prologue, and the set of included and bound types.
     /// </summary>
-    /// <value>The name of the generated GCCXML file.</value>
-    private string GccXmlFileName => Path.Combine(OutputPath, _configRoot.Id + "-gcc.xml");
+    private string ComputeConfigurationKey()
+    {
+        StringBuilder key = new();
+        key.Append(typeof(CppParser).Assembly.ManifestModule.ModuleVersionId).Append('\n');
+
+        foreach (var prologItem in _configRoot.ConfigFilesLoaded.SelectMany(file => file.IncludeProlog))
+            key.Append(prologItem).Append('\n');
+
+        foreach (var include in _includeToProcess.OrderBy(static x => x, StringComparer.OrdinalIgnoreCase))
+            key.Append(include).Append(';');
+
+        key.Append('\n');
+
+        foreach (var boundType in _boundTypes.OrderBy(static x => x, StringComparer.Ordinal))
+            key.Append(boundType).Append(';');
+
+        key.Append('\n');
+
+        return key.ToString();
+    }
 
     public string RootConfigHeaderFileName => Path.Combine(OutputPath, _configRoot.HeaderFileName);
 
+    public Dictionary<string, int> IncludeMacroCounts { get; } = new();
+
     /// <summary>
-    /// Gets or sets the GccXml doc.
+    /// Gets a key identifying the parser configuration: any change to it can change the parsed module.
     /// </summary>
-    /// <value>The GccXml doc.</value>
-    private XDocument GccXmlDoc { get; set; }
+    public string ConfigurationKey
+    {
+        get
+        {
+            StringBuilder key = new(_configurationKey);
 
-    public Dictionary<string, int> IncludeMacroCounts { get; } = new();
+            foreach (var includeRuleKey in _includeRuleKeys.OrderBy(static x => x.Key, StringComparer.OrdinalIgnoreCase))
+                key.Append(includeRuleKey.Key).Append(':').Append(includeRuleKey.Value);
+
+            return key.ToString();
+        }
+    }
 
     /// <summary>
     /// Runs this instance.
     /// </summary>
     /// <returns></returns>
-    public CppModule Run(CppModule groupSkeleton, StreamReader xmlReader)
+    public CppModule Run(CppModule groupSkeleton, StreamReader xmlReader) =>
+        Run(groupSkeleton, new[] { xmlReader }, new ISet<string>[] { null });
+
+    /// <summary>
+    /// Runs this instance over the outputs of CastXML shards, merging them into a single module.
+    /// </summary>
+    /// <param name="groupSkeleton">The module to populate.</param>
+    /// <param name="shards">The shards, each one only contributes the includes it owns.</param>
+    /// <param name="xmlReaders">The CastXML outputs, in the order of <paramref name="shards"/>.</param>
+    public CppModule Run(CppModule groupSkeleton, IReadOnlyList<CastXmlShard> shards, IReadOnlyList<StreamReader> xmlReaders)
+    {
+        if (shards.Count != xmlReaders.Count)
+            throw new ArgumentException("Each shard must have a CastXML output.", nameof(xmlReaders));
+
+        return Run(groupSkeleton, xmlReaders, shards.Select(static shard => shard.IncludeIds).ToArray());
+    }
+
+    private CppModule Run(CppModule groupSkeleton, IReadOnlyList<StreamReader> xmlReaders, IReadOnlyList<ISet<string>> includeFilters)
     {
         _group = groupSkeleton;
         Logger.Message("Config files changed.");
@@ -158,9 +214,12 @@ public sealed class CppParser
 
             Logger.Progress(15, progressMessage);
 
-            if (xmlReader != null)
+            for (var i = 0; i < xmlReaders.Count; i++)
             {
-                Parse(xmlReader);
+                if (xmlReaders[i] != null)
+                {
+                    Parse(xmlReaders[i], includeFilters[i]);
+                }
             }
 
             Logger.Progress(30, progressMessage);
@@ -173,19 +232,9 @@ public sealed class CppParser
         {
             Logger.Message("Parsing headers is finished.");
 
-            // Write back GCC-XML document on the disk
-            try
-            {
-                using var stream = File.Open(GccXmlFileName, FileMode.Create, FileAccess.Write);
-                GccXmlDoc?.Save(stream);
-            }
-            catch (Exception e)
-            {
-                Logger.LogRawMessage(
-                    LogLevel.Warning, LoggingCodes.ParserDiagnosticDumpIoError,
-                    "Writing GCC-XML file [{0}] failed", e, GccXmlFileName
-                );
-            }
+            // Release the element table, the parsed model doesn't reference it
+            _elements = null;
+            _parsedElements = null;
         }
 
         // Track number of included macros for statistics
@@ -204,64 +253,41 @@ public sealed class CppParser
     /// Parses the specified reader.
     /// </summary>
     /// <param name="reader">The reader.</param>
-    private void Parse(StreamReader reader)
+    /// <param name="includeFilter">The includes to parse, or <c>null</c> to parse all the includes to process.</param>
+    private void Parse(StreamReader reader, ISet<string> includeFilter)
     {
-        var doc = XDocument.Load(reader);
+        // Stream the CastXML output into a compact element table instead of a DOM
+        _elements = CastXmlElementTable.Load(reader);
+        _parsedElements = new CppElement[_elements.Count];
 
-        GccXmlDoc = doc;
-
-        // Collects all GccXml elements and build map from their id
-        foreach (var xElement in doc.Elements("GCC_XML").Elements())
-        {
-            var id = xElement.Attribute("id").Value;
-            _mapIdToXElement.Add(id, xElement);
-
-            var file = xElement.AttributeValue("file");
-            if (file != null)
-            {
-                if (!_mapFileToXElement.TryGetValue(file, out var elementsInFile))
-                {
-                    elementsInFile = new List<XElement>();
-                    _mapFileToXElement.Add(file, elementsInFile);
-                }
-                elementsInFile.Add(xElement);
-            }
-        }
+        // CastXML file ids are local to a document
+        _mapFileIdToIncludeId.Clear();
 
         // Fix all structure names
-        AdjustTypeNamesFromTypedefs(doc);
-
-        // Find all elements that are referring to a context and attach them to
-        // the context as child elements
-        foreach (var xElement in _mapIdToXElement.Values)
-        {
-            var id = xElement.AttributeValue("context");
-            if (id != null)
-            {
-                xElement.Remove();
-                _mapIdToXElement[id].Add(xElement);
-            }
-        }
+        AdjustTypeNamesFromTypedefs();
 
-        ParseAllElements();
+        ParseAllElements(includeFilter);
     }
 
-    private void AdjustTypeNamesFromTypedefs(XDocument doc)
+    private void AdjustTypeNamesFromTypedefs()
     {
-        foreach (var xTypedef in doc.Elements("GCC_XML").Elements(CastXml.TagTypedef))
+        for (int xTypedef = 0, count = _elements.Count; xTypedef < count; xTypedef++)
         {
-            var xStruct = _mapIdToXElement[xTypedef.AttributeValue("type")];
-            switch (xStruct.Name.LocalName)
+            if (_elements.Tag(xTypedef) != CastXml.TagTypedef)
+                continue;
+
+            var xStruct = _elements[_elements.TypeId(xTypedef)];
+            switch (_elements.Tag(xStruct))
             {
                 case CastXml.TagStruct:
                 case CastXml.TagUnion:
                 case CastXml.TagEnumeration:
-                    var structName = xStruct.AttributeValue("name");
+                    var structName = _elements.Name(xStruct);
                     // Rename all structure starting with tagXXXX to XXXX
                     if (structName.StartsWith("tag") || structName.StartsWith("_") || string.IsNullOrEmpty(structName))
                     {
-                        var typeName = xTypedef.AttributeValue("name");
-                        xStruct.SetAttributeValue("name", typeName);
+                        var typeName = _elements.Name(xTypedef);
+                        _elements.SetName(xStruct, typeName);
                     }
                     break;
             }
@@ -271,11 +297,11 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ function.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ function.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ function.</param>
     /// <returns>A C++ function parsed</returns>
-    private CppFunction ParseFunction(XElement xElement)
+    private CppFunction ParseFunction(int xElement)
     {
-        CppFunction cppMethod = new(xElement.AttributeValue("name"));
+        CppFunction cppMethod = new(_elements.Name(xElement));
         ParseCallable(cppMethod, xElement);
 
         return cppMethod;
@@ -284,17 +310,17 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ parameters.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ parameter.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ parameter.</param>
     /// <param name="methodOrFunction">The method or function to populate.</param>
-    private void ParseParameters(XElement xElement, CppContainer methodOrFunction)
+    private void ParseParameters(int xElement, CppContainer methodOrFunction)
     {
         var paramCount = 0;
-        foreach (var parameter in xElement.Elements())
+        foreach (var parameter in _elements.Children(xElement))
         {
-            if (parameter.Name.LocalName != "Argument")
+            if (_elements.Tag(parameter) != "Argument")
                 continue;
 
-            var name = parameter.AttributeValue("name");
+            var name = _elements.Name(parameter);
             if (string.IsNullOrEmpty(name))
                 name = "arg" + paramCount;
 
@@ -304,7 +330,7 @@ public sealed class CppParser
 
             Logger.PushContext("Parameter:[{0}]", cppParameter.Name);
 
-            ResolveAndFillType(parameter.AttributeValue("type"), cppParameter);
+            ResolveAndFillType(_elements.TypeId(parameter), cppParameter);
             methodOrFunction.Add(cppParameter);
 
             Logger.PopContext();
@@ -315,12 +341,12 @@ public sealed class CppParser
     /// <summary>
     /// Parses C++ annotations/attributes.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that contains C++ annotations/attributes.</param>
+    /// <param name="xElement">The gccxml element that contains C++ annotations/attributes.</param>
     /// <param name="cppElement">The C++ element to populate.</param>
-    private void ParseAnnotations(XElement xElement, CppElement cppElement)
+    private void ParseAnnotations(int xElement, CppElement cppElement)
     {
         // Check that the xml contains the "attributes" attribute
-        var attributes = xElement.AttributeValue("attributes");
+        var attributes = _elements.Attribute(xElement, "attributes");
         if (string.IsNullOrWhiteSpace(attributes))
             return;
 
@@ -464,9 +490,9 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ method or function.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ method/function declaration.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ method/function declaration.</param>
     /// <returns>The C++ parsed T.</returns>
-    private void ParseCallable(CppCallable cppCallable, XElement xElement)
+    private void ParseCallable(CppCallable cppCallable, int xElement)
     {
         Logger.PushContext("Callable:[{0}]", cppCallable.Name);
 
@@ -477,7 +503,7 @@ public sealed class CppParser
         ParseParameters(xElement, cppCallable);
 
         cppCallable.ReturnValue = new CppReturnValue();
-        ResolveAndFillType(xElement.AttributeValue("returns"), cppCallable.ReturnValue);
+        ResolveAndFillType(_elements.Attribute(xElement, "returns"), cppCallable.ReturnValue);
 
         Logger.PopContext();
     }
@@ -485,18 +511,18 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ COM interface.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ COM interface declaration.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ COM interface declaration.</param>
     /// <returns>A C++ interface parsed</returns>
-    private CppInterface ParseInterface(XElement xElement)
+    private CppInterface ParseInterface(int xElement)
     {
         // If element is already transformed, return it
-        var cppInterface = xElement.Annotation<CppInterface>();
+        var cppInterface = _parsedElements[xElement] as CppInterface;
         if (cppInterface != null)
             return cppInterface;
 
         // Else, create a new CppInterface
-        cppInterface = new CppInterface(xElement.AttributeValue("name"));
-        xElement.AddAnnotation(cppInterface);
+        cppInterface = new CppInterface(_elements.Name(xElement));
+        _parsedElements[xElement] = cppInterface;
 
         // Enter Interface description
         Logger.PushContext("Interface:[{0}]", cppInterface.Name);
@@ -504,14 +530,14 @@ public sealed class CppParser
         // Calculate offset method using inheritance
         var offsetMethod = 0;
 
-        var basesValue = xElement.AttributeValue("bases");
+        var basesValue = _elements.Attribute(xElement, "bases");
         var bases = basesValue?.Split(' ') ?? Enumerable.Empty<string>();
         foreach (var xElementBaseId in bases)
         {
             if (string.IsNullOrEmpty(xElementBaseId))
                 continue;
 
-            var xElementBase = _mapIdToXElement[xElementBaseId];
+            var xElementBase = _elements[xElementBaseId];
 
             CppInterface cppInterfaceBase = null;
             Logger.RunInContext("Base", () => { cppInterfaceBase = ParseInterface(xElementBase); });
@@ -530,13 +556,13 @@ public sealed class CppParser
         var methods = new List<CppMethod>();
 
         // Parse methods
-        foreach (var method in xElement.Elements())
+        foreach (var method in _elements.Children(xElement))
         {
             // Parse method with pure virtual (=0) and that do not override any other methods
-            if (method.Name.LocalName == "Method" && !string.IsNullOrWhiteSpace(method.AttributeValue("pure_virtual"))
-                                                  && string.IsNullOrWhiteSpace(method.AttributeValue("overrides")))
+            if (_elements.Tag(method) == "Method" && !string.IsNullOrWhiteSpace(_elements.Attribute(method, "pure_virtual"))
+                                                  && string.IsNullOrWhiteSpace(_elements.Attribute(method, "overrides")))
             {
-                CppMethod cppMethod = new(method.AttributeValue("name"));
+                CppMethod cppMethod = new(_elements.Name(method));
                 ParseCallable(cppMethod, method);
                 methods.Add(cppMethod);
                 cppMethod.Offset = offsetMethod++;
@@ -598,11 +624,11 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ field declaration.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ structure field declaration.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ structure field declaration.</param>
     /// <returns>A C++ field parsed</returns>
-    private CppField ParseField(XElement xElement, int fieldOffset)
+    private CppField ParseField(int xElement, int fieldOffset)
     {
-        var fieldName = xElement.AttributeValue("name");
+        var fieldName = _elements.Name(xElement);
         var cppField = new CppField(string.IsNullOrEmpty(fieldName) ? $"field{fieldOffset}" : fieldName)
         {
             Offset = fieldOffset
@@ -611,7 +637,7 @@ public sealed class CppParser
         Logger.PushContext("Field:[{0}]", cppField.Name);
 
         // Handle bitfield info
-        var bitField = xElement.AttributeValue("bits");
+        var bitField = _elements.Attribute(xElement, "bits");
         if (!string.IsNullOrEmpty(bitField))
         {
             cppField.IsBitField = true;
@@ -620,7 +646,7 @@ public sealed class CppParser
             cppField.BitOffset = int.Parse(bitField);
         }
 
-        ResolveAndFillType(xElement.AttributeValue("type"), cppField);
+        ResolveAndFillType(_elements.TypeId(xElement), cppField);
 
         Logger.PopContext();
         return cppField;
@@ -629,13 +655,13 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ struct or union declaration.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ struct or union declaration.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ struct or union declaration.</param>
     /// <param name="cppParent">The C++ parent object (valid for anonymous inner declaration) .</param>
     /// <param name="innerAnonymousIndex">An index that counts the number of anonymous declaration in order to set a unique name</param>
     /// <returns>A C++ struct parsed</returns>
-    private CppStruct ParseStructOrUnion(XElement xElement, CppElement cppParent = null, int innerAnonymousIndex = 0)
+    private CppStruct ParseStructOrUnion(int xElement, CppElement cppParent = null, int innerAnonymousIndex = 0)
     {
-        var cppStruct = xElement.Annotation<CppStruct>();
+        var cppStruct = _parsedElements[xElement] as CppStruct;
         if (cppStruct != null)
             return cppStruct;
 
@@ -644,14 +670,14 @@ public sealed class CppParser
 
         // Create struct
         cppStruct = new CppStruct(structName);
-        xElement.AddAnnotation(cppStruct);
-        var isUnion = (xElement.Name.LocalName == CastXml.TagUnion);
+        _parsedElements[xElement] = cppStruct;
+        var isUnion = (_elements.Tag(xElement) == CastXml.TagUnion);
         cppStruct.IsUnion = isUnion;
 
         // Enter struct/union description
-        Logger.PushContext("{0}:[{1}]", xElement.Name.LocalName, cppStruct.Name);
+        Logger.PushContext("{0}:[{1}]", _elements.Tag(xElement), cppStruct.Name);
 
-        var basesValue = xElement.AttributeValue("bases");
+        var basesValue = _elements.Attribute(xElement, "bases");
         var bases = basesValue != null ? basesValue.Split(' ') : Enumerable.Empty<string>();
 
         cppStruct.Base = GetStructDirectBase(bases);
@@ -659,18 +685,18 @@ public sealed class CppParser
         // Parse all fields
         var fieldOffset = 0;
         var innerStructCount = 0;
-        foreach (var field in xElement.Elements())
+        foreach (var field in _elements.Children(xElement))
         {
-            if (field.Name.LocalName != CastXml.TagField)
+            if (_elements.Tag(field) != CastXml.TagField)
                 continue;
 
             // Parse the field
             var cppField = ParseField(field, fieldOffset);
 
             // Test if the field type is declared inside this struct or union
-            var fieldName = field.AttributeValue("name");
-            var fieldType = _mapIdToXElement[field.AttributeValue("type")];
-            if (fieldType.AttributeValue("context") == xElement.AttributeValue("id"))
+            var fieldName = _elements.Name(field);
+            var fieldType = _elements[_elements.TypeId(field)];
+            if (_elements.Context(fieldType) == xElement)
             {
                 var fieldSubStruct = ParseStructOrUnion(fieldType, cppStruct, innerStructCount++);
                     
@@ -731,7 +757,7 @@ public sealed class CppParser
             if (string.IsNullOrEmpty(xElementBaseId))
                 continue;
 
-            var xElementBase = _mapIdToXElement[xElementBaseId];
+            var xElementBase = _elements[xElementBaseId];
 
             CppStruct cppStructBase = null;
             Logger.RunInContext("Base", () => { cppStructBase = ParseStructOrUnion(xElementBase); });
@@ -743,9 +769,9 @@ public sealed class CppParser
         return baseName;
     }
 
-    private static string GetStructName(XElement xElement, CppElement cppParent, int innerAnonymousIndex)
+    private string GetStructName(int xElement, CppElement cppParent, int innerAnonymousIndex)
     {
-        var structName = xElement.AttributeValue("name") ?? "";
+        var structName = _elements.Name(xElement) ?? "";
         if (cppParent != null)
         {
             if (string.IsNullOrEmpty(structName))
@@ -764,16 +790,16 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ enum declaration.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ enum declaration.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ enum declaration.</param>
     /// <returns>A C++ parsed enum</returns>
-    private CppEnum ParseEnum(XElement xElement)
+    private CppEnum ParseEnum(int xElement)
     {
-        var name = xElement.AttributeValue("name");
+        var name = _elements.Name(xElement);
 
         // Doh! Anonymous Enum, need to handle them!
         if (string.IsNullOrEmpty(name) || name.StartsWith("$"))
         {
-            var includeFrom = GetIncludeIdFromFileId(xElement.AttributeValue("file"));
+            var includeFrom = GetIncludeIdFromFileId(_elements.FileId(xElement));
 
             if (!_mapIncludeToAnonymousEnumCount.TryGetValue(includeFrom, out var enumOffset))
                 _mapIncludeToAnonymousEnumCount.Add(includeFrom, enumOffset);
@@ -785,16 +811,16 @@ public sealed class CppParser
 
         CppEnum cppEnum = new(name);
 
-        foreach (var xEnumItems in xElement.Elements())
+        foreach (var xEnumItems in _elements.Children(xElement))
         {
-            var enumItemName = xEnumItems.AttributeValue("name");
+            var enumItemName = _elements.Name(xEnumItems);
             if (enumItemName.EndsWith(CppExtensionHeaderGenerator.EndTagCustomEnumItem))
                 enumItemName = enumItemName.Substring(0, enumItemName.Length - CppExtensionHeaderGenerator.EndTagCustomEnumItem.Length);
 
-            cppEnum.AddEnumItem(enumItemName, xEnumItems.AttributeValue("init"));
+            cppEnum.AddEnumItem(enumItemName, _elements.Attribute(xEnumItems, "init"));
         }
 
-        if (ulong.TryParse(xElement.AttributeValue("size"), out var size))
+        if (ulong.TryParse(_elements.Attribute(xElement, "size"), out var size))
             cppEnum.UnderlyingType = size switch
             {
                 8 => "byte",
@@ -809,17 +835,17 @@ public sealed class CppParser
     /// <summary>
     /// Parses a C++ variable declaration/definition.
     /// </summary>
-    /// <param name="xElement">The gccxml <see cref="XElement"/> that describes a C++ variable declaration/definition.</param>
+    /// <param name="xElement">The gccxml element that describes a C++ variable declaration/definition.</param>
     /// <returns>A C++ parsed variable</returns>
-    private CppElement ParseVariable(XElement xElement)
+    private CppElement ParseVariable(int xElement)
     {
-        var name = xElement.AttributeValue("name");
+        var name = _elements.Name(xElement);
         if (name.EndsWith(CppExtensionHeaderGenerator.EndTagCustomVariable))
             name = name.Substring(0, name.Length - CppExtensionHeaderGenerator.EndTagCustomVariable.Length);
 
-        var typeName = ResolveType(xElement.AttributeValue("type"));
+        var typeName = ResolveType(_elements.TypeId(xElement));
 
-        var value = xElement.AttributeValue("init") ?? string.Empty;
+        var value = _elements.Attribute(xElement, "init") ?? string.Empty;
         if (typeName == "GUID")
         {
             var guid = ParseGuid(value);
@@ -882,9 +908,9 @@ public sealed class CppParser
     /// <summary>
     /// Parses all C++ elements. This is the main method that iterates on all types.
     /// </summary>
-    private void ParseAllElements()
+    private void ParseAllElements(ISet<string> includeFilter)
     {
-        foreach (var includeGccXmlId in _mapFileToXElement.Keys)
+        foreach (var includeGccXmlId in _elements.FileElements.Keys)
         {
             var includeId = GetIncludeIdFromFileId(includeGccXmlId);
 
@@ -896,6 +922,10 @@ public sealed class CppParser
             if (!_includeIsAttached.TryGetValue(includeId, out var isIncludeFullyAttached))
                 continue;
 
+            // Process only files owned by the current shard
+            if (includeFilter != null && !includeFilter.Contains(includeId))
+                continue;
+
             // Log current include being processed
             Logger.PushContext("Include:[{0}.h]", includeId);
 
@@ -914,19 +944,20 @@ public sealed class CppParser
 
     private void ParseElementsInInclude(string includeGccXmlId, string includeId, bool isIncludeFullyAttached)
     {
-        foreach (var xElement in _mapFileToXElement[includeGccXmlId])
+        foreach (var xElement in _elements.FileElements[includeGccXmlId])
         {
             // If the element is not defined from a root namespace
             // than skip it, as it might be an inner type
-            if (_mapIdToXElement[xElement.AttributeValue("context")].Name.LocalName != CastXml.TagNamespace)
+            var context = _elements.Context(xElement);
+            if (context == CastXmlElementTable.NoElement || _elements.Tag(context) != CastXml.TagNamespace)
                 continue;
 
             // If incomplete flag, than element cannot be parsed
-            if (xElement.AttributeValue("incomplete") != null)
+            if (_elements.Attribute(xElement, "incomplete") != null)
                 continue;
 
 
-            var elementName = xElement.AttributeValue("name");
+            var elementName = _elements.Name(xElement);
 
             // If this include is partially attached and the current type is not attached
             // Than skip it, as we are not mapping it
@@ -944,25 +975,25 @@ public sealed class CppParser
         }
     }
 
-    private CppElement ParseElement(XElement xElement)
+    private CppElement ParseElement(int xElement)
     {
-        switch (xElement.Name.LocalName)
+        switch (_elements.Tag(xElement))
         {
             case CastXml.TagEnumeration:
                 return ParseEnum(xElement);
             case CastXml.TagFunction:
                 // TODO: Find better criteria for exclusion. In CastXML extern="1" only indicates an explicit external storage modifier.
                 // For now, exclude inline functions instead; may not be sensible since by default all functions have external linkage.
-                if (xElement.AttributeValue("inline") == null)
+                if (_elements.Attribute(xElement, "inline") == null)
                     return ParseFunction(xElement);
                 break;
             case CastXml.TagClass:
             case CastXml.TagStruct:
-                return xElement.AttributeValue("abstract") != null ? (CppElement)ParseInterface(xElement) : ParseStructOrUnion(xElement);
+                return _elements.Attribute(xElement, "abstract") != null ? (CppElement)ParseInterface(xElement) : ParseStructOrUnion(xElement);
             case CastXml.TagUnion:
                 return ParseStructOrUnion(xElement);
             case CastXml.TagVariable:
-                if (xElement.AttributeValue("init") != null)
+                if (_elements.Attribute(xElement, "init") != null)
                     return ParseVariable(xElement);
                 break;
         }
@@ -976,9 +1007,9 @@ public sealed class CppParser
     /// <returns>
     /// 	<c>true</c> if the specified type is included in the mapping process; otherwise, <c>false</c>.
     /// </returns>
-    private bool IsTypeFromIncludeToProcess(XElement type)
+    private bool IsTypeFromIncludeToProcess(int type)
     {
-        var fileId = type.AttributeValue("file");
+        var fileId = _elements.FileId(type);
         if (fileId != null)
             return _includeToProcess.Contains(GetIncludeIdFromFileId(fileId));
         return false;
@@ -991,8 +1022,8 @@ public sealed class CppParser
     /// <returns>
     /// 	<c>true</c> if the specified type is bound in the mapping process; otherwise, <c>false</c>.
     /// </returns>
-    private bool IsTypeBinded(XElement type)
-        => IsTypeFromIncludeToProcess(type) || _boundTypes.Contains(type.AttributeValue("name"));
+    private bool IsTypeBinded(int type)
+        => IsTypeFromIncludeToProcess(type) || _boundTypes.Contains(_elements.Name(type));
 
     /// <summary>
     /// Resolves a type to its fundamental type or a binded type.
@@ -1003,15 +1034,15 @@ public sealed class CppParser
     /// <param name="type">The C++ type to fill.</param>
     private void ResolveAndFillType(string typeId, CppMarshallable type)
     {
-        var xType = _mapIdToXElement[typeId];
+        var xType = _elements[typeId];
 
         var isTypeResolved = false;
 
         while (!isTypeResolved)
         {
-            var name = xType.AttributeValue("name");
-            var nextType = xType.AttributeValue("type");
-            switch (xType.Name.LocalName)
+            var name = _elements.Name(xType);
+            var nextType = _elements.TypeId(xType);
+            switch (_elements.Tag(xType))
             {
                 case CastXml.TagFundamentalType:
                     type.TypeName = ConvertFundamentalType(name);
@@ -1030,27 +1061,27 @@ public sealed class CppParser
                         type.TypeName = name;
                         isTypeResolved = true;
                     }
-                    xType = _mapIdToXElement[nextType];
+                    xType = _elements[nextType];
                     break;
                 case CastXml.TagPointerType:
-                    xType = _mapIdToXElement[nextType];
+                    xType = _elements[nextType];
                     type.Pointer += "*";
                     break;
                 case CastXml.TagArrayType:
-                    var maxArrayIndex = xType.AttributeValue("max");
+                    var maxArrayIndex = _elements.Attribute(xType, "max");
                     var arrayDim = int.Parse(maxArrayIndex.TrimEnd('u')) + 1;
                     if (type.ArrayDimension == null)
                         type.ArrayDimension = arrayDim.ToString();
                     else
                         type.ArrayDimension += "," + arrayDim;
-                    xType = _mapIdToXElement[nextType];
+                    xType = _elements[nextType];
                     break;
                 case CastXml.TagReferenceType:
-                    xType = _mapIdToXElement[nextType];
+                    xType = _elements[nextType];
                     type.Pointer += "&";
                     break;
                 case CastXml.TagCvQualifiedType:
-                    xType = _mapIdToXElement[nextType];
+                    xType = _elements[nextType];
                     type.Const = true;
                     break;
                 case CastXml.TagFunctionType:
@@ -1059,20 +1090,20 @@ public sealed class CppParser
                     isTypeResolved = true;
                     break;
                 default:
-                    throw new InvalidOperationException(string.Format(CultureInfo.InvariantCulture, "Unexpected tag type [{0}]", xType.Name.LocalName));
+                    throw new InvalidOperationException(string.Format(CultureInfo.InvariantCulture, "Unexpected tag type [{0}]", _elements.Tag(xType)));
             }
         }
     }
 
     private string ResolveType(string typeId)
     {
-        var xType = _mapIdToXElement[typeId];
+        var xType = _elements[typeId];
 
         while (true)
         {
-            var name = xType.AttributeValue("name");
-            var nextType = xType.AttributeValue("type");
-            switch (xType.Name.LocalName)
+            var name = _elements.Name(xType);
+            var nextType = _elements.TypeId(xType);
+            switch (_elements.Tag(xType))
             {
                 case CastXml.TagFundamentalType:
                     return ConvertFundamentalType(name);
@@ -1086,19 +1117,19 @@ public sealed class CppParser
                     {
                         return name;
                     }
-                    xType = _mapIdToXElement[nextType];
+                    xType = _elements[nextType];
                     break;
                 case CastXml.TagPointerType:
                 case CastXml.TagArrayType:
                 case CastXml.TagReferenceType:
                 case CastXml.TagCvQualifiedType:
-                    xType = _mapIdToXElement[nextType];
+                    xType = _elements[nextType];
                     break;
                 case CastXml.TagFunctionType:
                     // TODO, handle different calling convention
                     return "__function__stdcall";
                 default:
-                    throw new InvalidOperationException(string.Format(CultureInfo.InvariantCulture, "Unexpected tag type [{0}]", xType.Name.LocalName));
+                    throw new InvalidOperationException(string.Format(CultureInfo.InvariantCulture, "Unexpected tag type [{0}]", _elements.Tag(xType)));
             }
         }
     }
@@ -1185,7 +1216,16 @@ public sealed class CppParser
     /// <returns>A include id</returns>
     private string GetIncludeIdFromFileId(string fileId)
     {
-        var filePath = _mapIdToXElement[fileId].AttributeValue("name");
+        if (_mapFileIdToIncludeId.TryGetValue(fileId, out var includeId))
+            return includeId;
+
+        includeId = ComputeIncludeIdFromFilePath(_elements.Name(_elements[fileId]));
+        _mapFileIdToIncludeId.Add(fileId, includeId);
+        return includeId;
+    }
+
+    private static string ComputeIncludeIdFromFilePath(string filePath)
+    {
         try
         {
             if (!File.Exists(filePath))
@@ -1,4 +1,5 @@
 using System;
+using System.Collections.Concurrent;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
@@ -7,9 +8,28 @@ using SharpGen.Doc;
 
 namespace SharpGen.Platform.Documentation;
 
+/// <summary>
+/// Cache of the documentation items, indexed by their names.
+/// </summary>
+/// <remarks>
+/// The cache is persisted as JSON lines, one line per item and its position in the cache.
+/// Only the new and the modified items are appended to an existing file, the last line of an item wins
+/// when the file is read. The file is rewritten once the superseded lines outnumber the items.
+/// </remarks>
 public sealed class DocItemCache
 {
+    private const byte NewLine = (byte) '\n';
+
     private readonly object syncObject = new();
+    private readonly List<IDocItem> items = new();
+
+    private readonly ConcurrentDictionary<string, IDocItem> index =
+        new(StringComparer.InvariantCultureIgnoreCase);
+
+    // The file backing the cache, its number of lines and the number of items it contains
+    private string persistedFile;
+    private int persistedLines;
+    private int persistedItems;
 
     internal static readonly JsonSerializerOptions JsonSerializerOptions = new()
     {
@@ -20,27 +40,121 @@ public sealed class DocItemCache
         }
     };
 
-    public List<IDocItem> DocItems { get; } = new();
+    public IReadOnlyList<IDocItem> DocItems
+    {
+        get
+        {
+            lock (syncObject)
+            {
+                return items.ToArray();
+            }
+        }
+    }
 
+    /// <summary>
+    /// Adds an item to the cache, indexed by the names it has.
+    /// </summary>
+    /// <param name="item">The item.</param>
     public void Add(IDocItem item)
     {
         lock (syncObject)
         {
-            DocItems.Add(item);
+            items.Add(item);
+            Index(item);
         }
     }
 
-    public IDocItem Find(string name)
+    public IDocItem Find(string name) => index.TryGetValue(name, out var item) ? item : null;
+
+    // The first item having a name is kept, like the lookups of the whole list did
+    private void Index(IDocItem item)
     {
-        lock (syncObject)
+        foreach (var name in item.Names)
+            index.TryAdd(name, item);
+    }
+
+    public static DocItemCache Read(string file)
+    {
+        DocItemCache cache = new();
+        var bytes = File.ReadAllBytes(file);
+
+        if (TryReadLegacy(bytes, cache))
+            return cache;
+
+        var lines = 0;
+        for (var start = 0; start < bytes.Length;)
         {
-            return DocItems.FirstOrDefault(item => item.Names.Contains(name));
+            var end = Array.IndexOf(bytes, NewLine, start);
+            if (end < 0)
+                end = bytes.Length;
+
+            var line = new ReadOnlySpan<byte>(bytes, start, end - start);
+            start = end + 1;
+
+            if (line.IsEmpty)
+                continue;
+
+            Entry entry;
+            try
+            {
+                entry = JsonSerializer.Deserialize<Entry>(line, JsonSerializerOptions);
+            }
+            catch (JsonException)
+            {
+                // Interrupted append, rewrite the file on the next write
+                cache.persistedFile = null;
+                break;
+            }
+
+            if (entry?.Item == null || entry.Index < 0 || entry.Index > cache.items.Count)
+            {
+                cache.persistedFile = null;
+                break;
+            }
+
+            if (entry.Index == cache.items.Count)
+                cache.items.Add(entry.Item);
+            else
+                cache.items[entry.Index] = entry.Item;
+
+            lines++;
+            cache.persistedFile ??= Path.GetFullPath(file);
         }
+
+        foreach (var item in cache.items)
+            cache.Index(item);
+
+        cache.persistedLines = lines;
+        cache.persistedItems = cache.items.Count;
+
+        return cache;
     }
 
-    public static DocItemCache Read(string file)
+    /// <summary>
+    /// Reads the single JSON object written by previous versions, the file is rewritten on the next write.
+    /// </summary>
+    private static bool TryReadLegacy(byte[] bytes, DocItemCache cache)
     {
-        return JsonSerializer.Deserialize<DocItemCache>(File.ReadAllBytes(file), JsonSerializerOptions);
+        Utf8JsonReader reader = new(bytes);
+
+        try
+        {
+            if (!reader.Read() || reader.TokenType != JsonTokenType.StartObject ||
+                !reader.Read() || reader.TokenType != JsonTokenType.PropertyName ||
+                !reader.ValueTextEquals(nameof(LegacyCache.DocItems)))
+                return false;
+        }
+        catch (JsonException)
+        {
+            return false;
+        }
+
+        var legacy = JsonSerializer.Deserialize<LegacyCache>(bytes, JsonSerializerOptions);
+
+        foreach (var item in legacy?.DocItems ?? Enumerable.Empty<IDocItem>())
+            cache.Add(item);
+
+        return true;
     }
 
     /// <summary>
@@ -49,12 +163,16 @@ public sealed class DocItemCache
     /// <param name="file">The file.</param>
     public void Write(string file)
     {
-        using var output = File.Create(file);
-        using var writer = new Utf8JsonWriter(output);
-
         lock (syncObject)
         {
-            JsonSerializer.Serialize(writer, this, JsonSerializerOptions);
+            using (var output = File.Create(file))
+            {
+                for (var i = 0; i < items.Count; i++)
+                    WriteEntry(output, i);
+            }
+
+            persistedFile = Path.GetFullPath(file);
+            persistedLines = persistedItems = items.Count;
         }
     }
 
@@ -64,25 +182,62 @@ public sealed class DocItemCache
     /// <param name="file">The file.</param>
     public void WriteIfDirty(string file)
     {
-        if (File.Exists(file))
+        lock (syncObject)
         {
-            bool touch;
+            if (!File.Exists(file) || !string.Equals(persistedFile, Path.GetFullPath(file), StringComparison.Ordinal))
+            {
+                Write(file);
+                return;
+            }
 
-            lock (syncObject)
+            // Just checking items for being dirty is enough, since we don't support removing items from cache.
+            List<int> changed = new();
+            for (var i = 0; i < items.Count; i++)
             {
-                // Just checking items for being dirty is enough, since we don't support removing items from cache.
-                touch = DocItems.All(x => !x.IsDirty);
+                if (i >= persistedItems || items[i].IsDirty)
+                    changed.Add(i);
             }
 
-            if (touch)
+            if (changed.Count == 0)
             {
-                // We need to touch the file regardless, since MSBuild depends on outputs being 
+                // We need to touch the file regardless, since MSBuild depends on outputs being
                 File.SetLastWriteTimeUtc(file, DateTime.UtcNow);
+                return;
+            }
 
+            if (persistedLines + changed.Count > 2 * items.Count)
+            {
+                Write(file);
                 return;
             }
+
+            using (var output = new FileStream(file, FileMode.Append, FileAccess.Write))
+            {
+                foreach (var i in changed)
+                    WriteEntry(output, i);
+            }
+
+            persistedLines += changed.Count;
+            persistedItems = items.Count;
         }
+    }
 
-        Write(file);
+    private void WriteEntry(Stream output, int i)
+    {
+        using (var writer = new Utf8JsonWriter(output))
+            JsonSerializer.Serialize(writer, new Entry { Index = i, Item = items[i] }, JsonSerializerOptions);
+
+        output.WriteByte(NewLine);
+    }
+
+    private sealed class Entry
+    {
+        public int Index { get; set; }
+        public IDocItem Item { get; set; }
+    }
+
+    private sealed class LegacyCache
+    {
+        public List<IDocItem> DocItems { get; set; }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,51 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Security.Cryptography;
+
+namespace SharpGen.Platform;
+
+/// <summary>
+/// Memoized SHA-256 hashes of file contents.
+/// </summary>
+internal sealed class FileHashCache
+{
+    private readonly Dictionary<string, string?> hashes = new(StringComparer.InvariantCultureIgnoreCase);
+
+    /// <summary>
+    /// Gets the hash of the file contents, or <c>null</c> if the file cannot be read.
+    /// </summary>
+    public string? GetHash(string path)
+    {
+        if (hashes.TryGetValue(path, out var hash))
+            return hash;
+
+        try
+        {
+            using var stream = File.OpenRead(path);
+            hash = ComputeHash(stream);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException or ArgumentException
+                                      or NotSupportedException)
+        {
+            hash = null;
+        }
+
+        hashes.Add(path, hash);
+        return hash;
+    }
+
+    public static string ComputeHash(Stream stream)
+    {
+        using var sha = SHA256.Create();
+        return Convert.ToBase64String(sha.ComputeHash(stream));
+    }
+
+    public static string ComputeHash(byte[] data)
+    {
+        using var sha = SHA256.Create();
+        return Convert.ToBase64String(sha.ComputeHash(data));
+    }
+}
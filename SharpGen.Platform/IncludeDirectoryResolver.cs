@@ -63,6 +63,35 @@ public sealed class IncludeDirectoryResolver : IIncludeDirectoryResolver
         }
     }
 
+    /// <summary>
+    /// Determines whether an include file is found in a system include directory.
+    /// </summary>
+    /// <remarks>
+    /// The override directories are searched first, like clang searches the <c>-I</c> directories
+    /// before the <c>-isystem</c> ones.
+    /// </remarks>
+    public bool IsSystemInclude(string file)
+    {
+        if (string.IsNullOrEmpty(file) || Path.IsPathRooted(file))
+            return false;
+
+        var paths = IncludePaths;
+
+        foreach (var item in paths)
+        {
+            if (item.Rule.IsOverride && File.Exists(Path.Combine(item.Path, file)))
+                return false;
+        }
+
+        foreach (var item in paths)
+        {
+            if (!item.Rule.IsOverride && File.Exists(Path.Combine(item.Path, file)))
+                return true;
+        }
+
+        return false;
+    }
+
     public IReadOnlyList<Item> IncludePaths
     {
         get
@@ -117,7 +117,7 @@ public class ComObject : CppObject, IUnknown
 #endif
     T>() where T : ComObject
     {
-        QueryInterface(typeof(T).GetTypeInfo().GUID, out var parentPtr).CheckError();
+        QueryInterface(TypeDataStorage.GetGuid<T>(), out var parentPtr).CheckError();
         return MarshallingHelpers.FromPointer<T>(parentPtr)!;
     }
 
@@ -210,7 +210,7 @@ public class ComObject : CppObject, IUnknown
 #endif
     T>() where T : ComObject
     {
-        return MarshallingHelpers.FromPointer<T>(QueryInterfaceOrNull(typeof(T).GetTypeInfo().GUID));
+        return MarshallingHelpers.FromPointer<T>(QueryInterfaceOrNull(TypeDataStorage.GetGuid<T>()));
     }
 
     ///<summary>
@@ -93,6 +93,9 @@ public class CppObject : DisposeBase, ICallbackable, IEquatable<CppObject>
             if (ObjectTrackerReadOnlyConfiguration.IsEnabled)
                 ObjectTracker.MigrateNativePointer(this, oldNativePointer, value);
 
+            if (CppObjectIdentityCache.IsUsed)
+                CppObjectIdentityCache.Remove(oldNativePointer, this);
+
             NativePointerUpdated(oldNativePointer);
         }
     }
@@ -176,6 +179,9 @@ public class CppObject : DisposeBase, ICallbackable, IEquatable<CppObject>
         if (ObjectTrackerReadOnlyConfiguration.IsEnabled)
             ObjectTracker.Untrack(this, nativePointer);
 
+        if (CppObjectIdentityCache.IsUsed)
+            CppObjectIdentityCache.Remove(nativePointer, this);
+
         // Set pointer to null (using protected members in order to avoid callbacks).
 #if DEBUG
         var oldNativePointer = Interlocked.Exchange(ref _nativePointer, IntPtr.Zero);
@@ -0,0 +1,58 @@
+#nullable enable
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+
+namespace SharpGen.Runtime;
+
+/// <summary>
+/// Maps the native pointers to the <see cref="ComObject"/> wrappers created for them by
+/// <see cref="MarshallingHelpers.FromPointerCached{T}"/>, without keeping the wrappers alive.
+/// </summary>
+/// <remarks>
+/// A wrapper leaves the cache when it is disposed or finalized, or when its native pointer changes.
+/// </remarks>
+internal static class CppObjectIdentityCache
+{
+    private static readonly ConcurrentDictionary<IntPtr, WeakReference<CppObject>> wrappers = new();
+
+    // Saves a lookup on every dispose until the cache is first used
+    private static volatile bool isUsed;
+
+    public static bool IsUsed => isUsed;
+
+    public static bool TryGet(IntPtr nativePointer, out CppObject? wrapper)
+    {
+        if (isUsed && wrappers.TryGetValue(nativePointer, out var entry) &&
+            entry.TryGetTarget(out var target) && target.NativePointer == nativePointer)
+        {
+            wrapper = target;
+            return true;
+        }
+
+        wrapper = null;
+        return false;
+    }
+
+    public static void Add(IntPtr nativePointer, CppObject wrapper)
+    {
+        isUsed = true;
+        wrappers[nativePointer] = new WeakReference<CppObject>(wrapper);
+    }
+
+    public static void Remove(IntPtr nativePointer, CppObject wrapper)
+    {
+        if (!wrappers.TryGetValue(nativePointer, out var entry))
+            return;
+
+        // A dead entry belongs to a collected wrapper, whichever it was
+        if (entry.TryGetTarget(out var target) && !ReferenceEquals(target, wrapper))
+            return;
+
+        // Only removes the entry if it wasn't replaced in the meantime
+        ((ICollection<KeyValuePair<IntPtr, WeakReference<CppObject>>>) wrappers).Remove(
+            new KeyValuePair<IntPtr, WeakReference<CppObject>>(nativePointer, entry)
+        );
+    }
+}
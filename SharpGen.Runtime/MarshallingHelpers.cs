@@ -23,6 +23,47 @@ public static partial class MarshallingHelpers
         return result;
     }
 
+    /// <summary>
+    /// Returns the wrapper of a native pointer already created by this method if it is still alive,
+    /// or instantiates and caches a new one.
+    /// </summary>
+    /// <typeparam name="T">The CppObject class that will be returned</typeparam>
+    /// <param name="cppObjectPtr">The native pointer to a C++ object, owning a reference to it.</param>
+    /// <param name="factory">Creates the wrapper when none is cached.</param>
+    /// <returns>An instance of T bound to the native pointer</returns>
+    /// <remarks>
+    /// <para>
+    /// Only the <see cref="ComObject"/> wrappers are cached. A cached wrapper owns a single reference to the native
+    /// object, so the reference owned by <paramref name="cppObjectPtr"/> is released when it is returned.
+    /// </para>
+    /// <para>
+    /// The callers receiving the same pointer share the same wrapper: disposing it disposes it for all of them.
+    /// </para>
+    /// </remarks>
+    public static T? FromPointerCached<T>(IntPtr cppObjectPtr, Func<IntPtr, T> factory) where T : CppObject
+    {
+        if (cppObjectPtr == IntPtr.Zero)
+            return default;
+
+        // The cached wrapper can be disposed by another thread at any time: the incoming reference keeps the
+        // native object alive until the wrapper is found still bound to it, and is released through its own vtable.
+        if (CppObjectIdentityCache.TryGet(cppObjectPtr, out var cached) && cached is T result)
+        {
+            ReleaseReference(cppObjectPtr);
+            return result;
+        }
+
+        result = factory(cppObjectPtr);
+
+        if (result is ComObject)
+            CppObjectIdentityCache.Add(cppObjectPtr, result);
+
+        return result;
+    }
+
+    private static unsafe void ReleaseReference(IntPtr unknownPtr) =>
+        ((delegate* unmanaged[Stdcall]<IntPtr, uint>) (*(void***) unknownPtr)[2])(unknownPtr);
+
     /// <summary>
     /// Instantiate a CppObject from a native pointer.
     /// </summary>
@@ -38,6 +79,9 @@ public static partial class MarshallingHelpers
         if (cppObjectPtr == IntPtr.Zero)
             return default;
 
+        if (TypeDataStorage.Storage<T>.Factory is { } factory)
+            return factory(cppObjectPtr);
+
         object? result = Activator.CreateInstance(typeof(T), cppObjectPtr);
         if (result is null)
             return default;
@@ -60,6 +104,9 @@ public static partial class MarshallingHelpers
         if (cppObjectPtr == UIntPtr.Zero)
             return default;
 
+        if (TypeDataStorage.Storage<T>.Factory is { } factory)
+            return factory(unchecked((nint) (nuint) cppObjectPtr));
+
         object? result = Activator.CreateInstance(typeof(T), cppObjectPtr);
         if (result is null)
             return default;
@@ -68,6 +68,19 @@ public static unsafe class TypeDataStorage
 
     internal static void Register(Guid guid, void* vtbl) => vtblByGuid[guid] = new IntPtr(vtbl);
 
+    /// <summary>
+    /// Checks whether the composed vtable of <typeparamref name="T"/> is already registered,
+    /// usually by the module initializer of the assembly declaring it.
+    /// </summary>
+    public static bool IsRegistered<T>() where T : ICallbackable
+    {
+#if !FORCE_REFLECTION_ONLY
+        return vtblByGuid.ContainsKey(GetGuid<T>());
+#else
+        return false;
+#endif
+    }
+
     internal static IntPtr[]? GetSourceVtbl<T>() where T : ICallbackable
     {
 #if !FORCE_REFLECTION_ONLY
@@ -167,21 +180,50 @@ public static unsafe class TypeDataStorage
             if (iSourceVtbl is null)
                 throw new Exception($"Failed to reflect Vtbl out of an {nameof(ICallbackable)} interface '{iface.FullName}'.");
 
-            items.Add(new RegisterInheritanceItem(typeInfo, typeInfo.ImplementedInterfaces.Count(), iSourceVtbl));
+            items.Add(new RegisterInheritanceItem(typeInfo, iSourceVtbl));
         }
 
-        // TODO: properly sort items by inheritance
         // TODO: verify single inheritance
-        items.Sort(static (x, y) => Comparer<int>.Default.Compare(x.InterfaceCount, y.InterfaceCount));
-
-        foreach (var (_, _, iSourceVtbl) in items)
-            helper.Add(iSourceVtbl);
+        foreach (var item in SortByInheritance(items))
+            helper.Add(item.SourceVtbl);
 
         helper.Add(sourceVtbl);
         return helper.Register(type);
     }
 
-    private record struct RegisterInheritanceItem(TypeInfo Type, int InterfaceCount, IntPtr[] SourceVtbl);
+    /// <summary>
+    /// Orders the interfaces so that every interface comes after the interfaces it inherits,
+    /// keeping the declaration order otherwise. The source generator emits the same order.
+    /// </summary>
+    private static List<RegisterInheritanceItem> SortByInheritance(List<RegisterInheritanceItem> items)
+    {
+        List<RegisterInheritanceItem> sorted = new(items.Count);
+        var visited = new bool[items.Count];
+
+        void Visit(int index)
+        {
+            if (visited[index])
+                return;
+
+            visited[index] = true;
+
+            var type = items[index].Type;
+            for (var i = 0; i < items.Count; i++)
+            {
+                if (i != index && items[i].Type.IsAssignableFrom(type))
+                    Visit(i);
+            }
+
+            sorted.Add(items[index]);
+        }
+
+        for (var i = 0; i < items.Count; i++)
+            Visit(i);
+
+        return sorted;
+    }
+
+    private record struct RegisterInheritanceItem(TypeInfo Type, IntPtr[] SourceVtbl);
 
     [SuppressMessage("ReSharper", "StaticMemberInGenericType")]
     [SuppressMessage("Usage", "CA2211:Non-constant fields should not be visible")]
@@ -189,5 +231,13 @@ public static unsafe class TypeDataStorage
     {
         public static Guid Guid;
         public static IntPtr[]? SourceVtbl;
+
+        /// <summary>
+        /// Creates the wrapper of a native pointer, registered by the module initializer of the assemblies
+        /// passing <typeparamref name="T"/> to the generic helpers creating wrappers, like
+        /// <see cref="ComObject.QueryInterface{T}()"/>, so that <see cref="MarshallingHelpers.FromPointer{T}(IntPtr)"/>
+        /// doesn't use reflection.
+        /// </summary>
+        public static Func<IntPtr, T>? Factory;
     }
 }
\ No newline at end of file
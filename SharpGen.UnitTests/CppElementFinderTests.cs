@@ -0,0 +1,119 @@
+using System.Linq;
+using System.Text.RegularExpressions;
+using SharpGen.CppModel;
+using SharpGen.Model;
+using Xunit;
+
+namespace SharpGen.UnitTests;
+
+public class CppElementFinderTests
+{
+    private static CppModule CreateModule()
+    {
+        var include = new CppInclude("include");
+
+        var cppInterface = new CppInterface("IInterface");
+        var method = new CppMethod("Method");
+        method.Add(new CppParameter("param"));
+        cppInterface.Add(method);
+        cppInterface.Add(new CppMethod("OtherMethod"));
+        include.Add(cppInterface);
+
+        var cppStruct = new CppStruct("Struct");
+        cppStruct.Add(new CppField("field"));
+        include.Add(cppStruct);
+        include.Add(new CppStruct("StructOther"));
+
+        var otherInclude = new CppInclude("other");
+        otherInclude.Add(new CppStruct("Struct2"));
+
+        var module = new CppModule("Module");
+        module.Add(include);
+        module.Add(otherInclude);
+        return module;
+    }
+
+    [Theory]
+    [InlineData("^Struct$", "Struct", true)]
+    [InlineData("^IInterface::Method$", "IInterface::Method", true)]
+    [InlineData(@"^IInterface\:\:.*$", "IInterface::", false)]
+    [InlineData(@"^Struct\d+$", "Struct", false)]
+    [InlineData("^Structs?$", "Struct", false)]
+    [InlineData("^Struct(Other)?$", "Struct", false)]
+    [InlineData("^.*$", "", false)]
+    [InlineData("^$", "", true)]
+    public void LiteralPrefixIsExtracted(string pattern, string prefix, bool isExact)
+    {
+        Assert.True(CppElementIndex.TryGetLiteralPrefix(new Regex(pattern), out var actualPrefix, out var actualIsExact));
+        Assert.Equal(prefix, actualPrefix);
+        Assert.Equal(isExact, actualIsExact);
+    }
+
+    [Theory]
+    [InlineData("Struct$")]
+    [InlineData("^Struct|Other$")]
+    public void LiteralPrefixIsNotExtractedFromUnanchoredRegex(string pattern)
+    {
+        Assert.False(CppElementIndex.TryGetLiteralPrefix(new Regex(pattern), out _, out _));
+    }
+
+    [Fact]
+    public void LiteralPrefixIsNotExtractedFromCaseInsensitiveRegex()
+    {
+        Assert.False(CppElementIndex.TryGetLiteralPrefix(new Regex("^Struct$", RegexOptions.IgnoreCase), out _, out _));
+    }
+
+    [Fact]
+    public void FindMatchesKindAndFullName()
+    {
+        var finder = new CppElementFinder(CreateModule());
+
+        Assert.Equal(new[] { "Struct", "StructOther", "Struct2" }, finder.Find<CppStruct>("Struct.*").Select(x => x.Name));
+        Assert.Equal("Method", Assert.Single(finder.Find<CppMethod>("IInterface::Method")).Name);
+        Assert.Equal(new[] { "Method", "OtherMethod" }, finder.Find<CppMethod>("IInterface::.*").Select(x => x.Name));
+        Assert.Equal("param", Assert.Single(finder.Find<CppParameter>(@"IInterface::Method::\w+")).Name);
+        Assert.Empty(finder.Find<CppStruct>("IInterface"));
+        Assert.Empty(finder.Find<CppStruct>("struct"));
+    }
+
+    [Fact]
+    public void FindSelectsParentOfMatchedElement()
+    {
+        var finder = new CppElementFinder(CreateModule());
+
+        var parents = finder.Find<CppInterface>("IInterface::.*", CppElementFinder.SelectionMode.Parent).ToList();
+
+        Assert.Equal(2, parents.Count);
+        Assert.All(parents, x => Assert.Equal("IInterface", x.Name));
+    }
+
+    [Fact]
+    public void FindRestrictsToCurrentContexts()
+    {
+        var finder = new CppElementFinder(CreateModule());
+
+        finder.AddContexts(new[] { "other" });
+        Assert.Equal("Struct2", Assert.Single(finder.Find<CppStruct>("Struct.*")).Name);
+
+        finder.ClearCurrentContexts();
+        Assert.Equal(3, finder.Find<CppStruct>("Struct.*").Count());
+    }
+
+    [Fact]
+    public void FindFollowsTreeChanges()
+    {
+        var module = CreateModule();
+        var finder = new CppElementFinder(module);
+
+        Assert.Equal(3, finder.Find<CppStruct>("Struct.*").Count());
+
+        finder.Find<CppStruct>("StructOther").Single().RemoveFromParent();
+        Assert.Equal(new[] { "Struct", "Struct2" }, finder.Find<CppStruct>("Struct.*").Select(x => x.Name));
+
+        module.Includes.First().Add(new CppStruct("StructAdded"));
+        Assert.Equal(
+            new[] { "Struct", "StructAdded", "Struct2" },
+            new CppElementFinder(module).Find<CppStruct>("Struct.*").Select(x => x.Name)
+        );
+    }
+}
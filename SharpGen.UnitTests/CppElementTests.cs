@@ -0,0 +1,32 @@
+using SharpGen.CppModel;
+using Xunit;
+
+namespace SharpGen.UnitTests;
+
+public class CppElementTests
+{
+    [Fact]
+    public void FullNameIsUpdatedWhenParentChanges()
+    {
+        var field = new CppField("field");
+        var inner = new CppStruct("Inner");
+        inner.Add(field);
+
+        var include = new CppInclude("include");
+        include.Add(inner);
+
+        Assert.Equal("Inner::field", field.FullName);
+
+        var outer = new CppStruct("Outer");
+        include.Add(outer);
+        outer.Add(inner);
+
+        Assert.Equal("Outer::Inner", inner.FullName);
+        Assert.Equal("Outer::Inner::field", field.FullName);
+
+        inner.RemoveFromParent();
+
+        Assert.Equal("Inner", inner.FullName);
+        Assert.Equal("Inner::field", field.FullName);
+    }
+}
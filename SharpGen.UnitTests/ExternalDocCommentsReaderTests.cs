@@ -0,0 +1,68 @@
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+using System.Xml;
+using SharpGen.Model;
+using SharpGen.Transform;
+using Xunit;
+
+namespace SharpGen.UnitTests;
+
+public class ExternalDocCommentsReaderTests
+{
+    private const string Comments = @"<?xml version=""1.0"" encoding=""utf-8""?>
+<!-- Header -->
+<comments>
+    <comment id=""PAIR"">
+        <summary>A pair.</summary>
+        <comment id=""NESTED"" />
+    </comment>
+    <comment />
+    <other id=""OTHER"" />
+    <comment id=""PAIR::First""><summary>First.</summary></comment>
+</comments>";
+
+    private static List<string> ReadCommentIds(string xml) =>
+        ExternalDocCommentsReader.ReadCommentIds(new MemoryStream(Encoding.UTF8.GetBytes(xml)));
+
+    [Fact]
+    public void TopLevelCommentIdsAreRead()
+    {
+        Assert.Equal(new[] { "PAIR", "PAIR::First" }, ReadCommentIds(Comments));
+    }
+
+    [Fact]
+    public void OtherRootElementHasNoComments()
+    {
+        Assert.Empty(ReadCommentIds(@"<docs><comment id=""PAIR"" /></docs>"));
+        Assert.Empty(ReadCommentIds(@"<comments />"));
+    }
+
+    [Fact]
+    public void FirstDocumentWithCommentWins()
+    {
+        ExternalDocCommentsReader reader = new(
+            new (string, IEnumerable<string>)[]
+            {
+                ("first.xml", new[] { "PAIR" }),
+                ("second.xml", new[] { "PAIR", "TRIPLE" })
+            }
+        );
+
+        Assert.Equal("first.xml", reader.GetDocumentWithExternalComments(new CsStruct(null, "PAIR") { CppElementName = "PAIR" }));
+        Assert.Equal("second.xml", reader.GetDocumentWithExternalComments(new CsStruct(null, "TRIPLE") { CppElementName = "TRIPLE" }));
+        Assert.Null(reader.GetDocumentWithExternalComments(new CsStruct(null, "QUAD") { CppElementName = "QUAD" }));
+    }
+
+    [Fact]
+    public void XmlDocumentsAreIndexed()
+    {
+        XmlDocument document = new();
+        document.LoadXml(Comments);
+
+        ExternalDocCommentsReader reader = new(new Dictionary<string, XmlDocument> { ["doc.xml"] = document });
+
+        Assert.Equal("doc.xml", reader.GetDocumentWithExternalComments(new CsStruct(null, "PAIR") { CppElementName = "PAIR" }));
+        Assert.Null(reader.GetDocumentWithExternalComments(new CsStruct(null, "NESTED") { CppElementName = "NESTED" }));
+    }
+}
@@ -0,0 +1,105 @@
+using SharpGen.Config;
+using SharpGen.CppModel;
+using SharpGen.UnitTests.Mapping;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace SharpGen.UnitTests;
+
+public class FunctionPointerImportsTests : MappingTestBase
+{
+    public FunctionPointerImportsTests(ITestOutputHelper outputHelper) : base(outputHelper)
+    {
+    }
+
+    [Fact]
+    public void FunctionsAreCalledThroughLazilyBoundPointers()
+    {
+        Ioc.GeneratorConfig.FunctionPointerImports = true;
+
+        var code = Generate();
+
+        Assert.DoesNotContain("DllImport", code);
+        Assert.Contains("private static unsafe class __Imports", code);
+        Assert.Contains(
+            "private static readonly System.IntPtr Library0 = System.Runtime.InteropServices.NativeLibrary.Load(\"Test.dll\", typeof(__Imports).Assembly, null);",
+            code
+        );
+        Assert.Contains(
+            "internal static readonly void* First = (void*)System.Runtime.InteropServices.NativeLibrary.GetExport(Library0, \"First\");",
+            code
+        );
+        Assert.Contains(
+            "internal static readonly void* Second = (void*)System.Runtime.InteropServices.NativeLibrary.GetExport(Library1, \"Second\");",
+            code
+        );
+        Assert.Contains("((delegate* unmanaged[Cdecl]<int, int> )__Imports.Second)(value)", code);
+        AssertCompiles(code);
+    }
+
+    [Fact]
+    public void FunctionsAreImportedByDefault()
+    {
+        var code = Generate();
+
+        Assert.DoesNotContain("__Imports", code);
+        Assert.Contains("[System.Runtime.InteropServices.DllImportAttribute(\"Test.dll\", EntryPoint = \"First\"", code);
+        AssertCompiles(code);
+    }
+
+    private string Generate()
+    {
+        var config = new ConfigFile
+        {
+            Id = nameof(FunctionPointerImportsTests),
+            Namespace = nameof(FunctionPointerImportsTests),
+            Includes =
+            {
+                new IncludeRule
+                {
+                    Attach = true,
+                    File = "func.h",
+                    Namespace = nameof(FunctionPointerImportsTests)
+                }
+            },
+            Extension =
+            {
+                new CreateExtensionRule
+                {
+                    NewClass = $"{nameof(FunctionPointerImportsTests)}.Functions",
+                }
+            },
+            Bindings =
+            {
+                new BindRule("int", "System.Int32")
+            },
+            Mappings =
+            {
+                new MappingRule
+                {
+                    Function = "First",
+                    FunctionDllName = "\"Test.dll\"",
+                    Group = $"{nameof(FunctionPointerImportsTests)}.Functions"
+                },
+                new MappingRule
+                {
+                    Function = "Second",
+                    FunctionDllName = "\"Other.dll\"",
+                    Group = $"{nameof(FunctionPointerImportsTests)}.Functions"
+                }
+            }
+        };
+
+        var include = new CppInclude("func");
+        include.Add(new CppFunction("First") { ReturnValue = new CppReturnValue { TypeName = "int" } });
+
+        var second = new CppFunction("Second") { ReturnValue = new CppReturnValue { TypeName = "int" } };
+        second.Add(new CppParameter("value") { TypeName = "int" });
+        include.Add(second);
+
+        var module = new CppModule("SharpGenTestModule");
+        module.Add(include);
+
+        return GenerateCode(module, config);
+    }
+}
@@ -0,0 +1,102 @@
+using SharpGen.Config;
+using SharpGen.CppModel;
+using SharpGen.UnitTests.Mapping;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace SharpGen.UnitTests;
+
+public class FunctionPointerShadowsTests : MappingTestBase
+{
+    public FunctionPointerShadowsTests(ITestOutputHelper outputHelper) : base(outputHelper)
+    {
+    }
+
+    [Fact]
+    public void DelegatesAreGeneratedBeforeNet6ByDefault()
+    {
+        var code = Generate();
+
+        Assert.Contains("#if NET6_0_OR_GREATER", code);
+        Assert.Contains("private static readonly BlittableDelegate_ BlittableDelegateCache_ = BlittableImpl_;", code);
+        Assert.Contains("System.Runtime.InteropServices.Marshal.GetFunctionPointerForDelegate(PointerDelegateCache_)", code);
+        Assert.Contains("private delegate int PointerDelegate_(System.IntPtr thisObject, void* _value);", code);
+    }
+
+    [Fact]
+    public void ShadowsAreDelegateFree()
+    {
+        Ioc.GeneratorConfig.FunctionPointerShadows = true;
+
+        var code = Generate();
+
+        Assert.DoesNotContain("#if", code);
+        Assert.DoesNotContain("BlittableDelegate", code);
+        Assert.DoesNotContain("PointerDelegate", code);
+        Assert.Contains("(System.IntPtr)((delegate* unmanaged[Thiscall]<System.IntPtr, int, int> )(&BlittableImpl_))", code);
+        Assert.Contains("(System.IntPtr)((delegate* unmanaged[Thiscall]<System.IntPtr, void*, int> )(&PointerImpl_))", code);
+
+        // A value marshalled by the runtime can't cross an UnmanagedCallersOnly method
+        Assert.Contains("private delegate int MarshalledDelegate_(System.IntPtr thisObject, bool _value);", code);
+        Assert.Contains("System.Runtime.InteropServices.Marshal.GetFunctionPointerForDelegate(MarshalledDelegateCache_)", code);
+
+        AssertCompiles(code);
+    }
+
+    private string Generate()
+    {
+        var config = new ConfigFile
+        {
+            Id = nameof(FunctionPointerShadowsTests),
+            Namespace = nameof(FunctionPointerShadowsTests),
+            Includes =
+            {
+                new IncludeRule
+                {
+                    File = "interface.h",
+                    Attach = true,
+                    Namespace = nameof(FunctionPointerShadowsTests)
+                }
+            },
+            Bindings =
+            {
+                new BindRule("int", "System.Int32"),
+                new BindRule("bool", "System.Boolean")
+            },
+            Mappings =
+            {
+                new MappingRule
+                {
+                    Interface = "Interface",
+                    IsCallbackInterface = true
+                }
+            }
+        };
+
+        var iface = new CppInterface("Interface");
+        iface.Add(CreateMethod("Blittable", "int", 0));
+        iface.Add(CreateMethod("Pointer", "wchar_t", 1, "*"));
+        iface.Add(CreateMethod("Marshalled", "bool", 2));
+
+        var include = new CppInclude("interface");
+        include.Add(iface);
+
+        var module = new CppModule("SharpGenTestModule");
+        module.Add(include);
+
+        return GenerateCode(module, config);
+    }
+
+    private static CppMethod CreateMethod(string name, string parameterType, int offset, string pointer = "")
+    {
+        CppMethod method = new(name)
+        {
+            ReturnValue = new CppReturnValue { TypeName = "int" },
+            Offset = offset,
+            WindowsOffset = offset
+        };
+
+        method.Add(new CppParameter("value") { TypeName = parameterType, Pointer = pointer });
+        return method;
+    }
+}
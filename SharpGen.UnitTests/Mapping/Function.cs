@@ -205,4 +205,81 @@ public class Function : MappingTestBase
 
         Assert.False(Logger.HasErrors);
     }
+
+    [Fact]
+    public void ParallelTransformKeepsFunctionOrder()
+    {
+        const int functionCount = 64;
+
+        var config = new ConfigFile
+        {
+            Id = nameof(ParallelTransformKeepsFunctionOrder),
+            Namespace = nameof(ParallelTransformKeepsFunctionOrder),
+            Includes =
+            {
+                new IncludeRule
+                {
+                    Attach = true,
+                    File = "func.h",
+                    Namespace = nameof(ParallelTransformKeepsFunctionOrder)
+                }
+            },
+            Extension =
+            {
+                new CreateExtensionRule
+                {
+                    NewClass = $"{nameof(ParallelTransformKeepsFunctionOrder)}.Functions",
+                }
+            },
+            Bindings =
+            {
+                new BindRule("int", "System.Int32")
+            },
+            Mappings =
+            {
+                new MappingRule
+                {
+                    Function = "Test.*",
+                    FunctionDllName = "\"Test.dll\"",
+                    Group = $"{nameof(ParallelTransformKeepsFunctionOrder)}.Functions"
+                }
+            }
+        };
+
+        var include = new CppInclude("func");
+
+        var module = new CppModule("SharpGenTestModule");
+
+        for (var i = 0; i < functionCount; i++)
+        {
+            var function = new CppFunction($"Test{i}")
+            {
+                ReturnValue = new CppReturnValue
+                {
+                    TypeName = "int",
+                }
+            };
+            function.Add(new CppParameter("value") { TypeName = "int" });
+            include.Add(function);
+        }
+
+        module.Add(include);
+
+        var (solution, _) = MapModel(module, config, maxDegreeOfParallelism: 4);
+
+        var group = solution.EnumerateDescendants<CsGroup>().Single();
+
+        Assert.Equal(
+            Enumerable.Range(0, functionCount).Select(i => $"Test{i}"),
+            group.Functions.Select(x => x.Name)
+        );
+
+        Assert.All(group.Functions, x =>
+        {
+            Assert.Equal(TypeRegistry.Int32, x.ReturnValue.PublicType);
+            Assert.Equal(TypeRegistry.Int32, Assert.Single(x.Parameters).PublicType);
+        });
+
+        Assert.False(Logger.HasErrors);
+    }
 }
\ No newline at end of file
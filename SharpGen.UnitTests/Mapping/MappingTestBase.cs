@@ -1,9 +1,16 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Xml;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
 using SharpGen.Config;
 using SharpGen.CppModel;
+using SharpGen.Generator;
 using SharpGen.Model;
 using SharpGen.Transform;
+using Xunit;
 using Xunit.Abstractions;
 
 namespace SharpGen.UnitTests.Mapping;
@@ -15,9 +22,11 @@ public abstract class MappingTestBase : TestBase
     {
     }
 
-    protected (CsAssembly Assembly, IEnumerable<DefineExtensionRule> Defines) MapModel(CppModule module, ConfigFile config)
+    protected (CsAssembly Assembly, IEnumerable<DefineExtensionRule> Defines) MapModel(CppModule module, ConfigFile config,
+                                                                                       int maxDegreeOfParallelism = 1)
     {
         var transformer = CreateTransformer();
+        transformer.MaxDegreeOfParallelism = maxDegreeOfParallelism;
         config.Load(null, Array.Empty<string>(), Logger);
         return transformer.Transform(module, config);
     }
@@ -31,6 +40,34 @@ public abstract class MappingTestBase : TestBase
         return transformer.GenerateTypeBindingsForConsumers();
     }
 
+    protected string GenerateCode(CppModule module, ConfigFile config)
+    {
+        var (solution, _) = MapModel(module, config);
+
+        AddIocServices(container => container.AddService(new ExternalDocCommentsReader(new Dictionary<string, XmlDocument>())));
+        AddIocServices(container => container.AddService<IGeneratorRegistry>(new DefaultGenerators(Ioc)));
+
+        return new RoslynGenerator().Run(solution, Ioc).GetCompilationUnitRoot().ToFullString();
+    }
+
+    protected void AssertCompiles(string code)
+    {
+        var references = ((string) AppContext.GetData("TRUSTED_PLATFORM_ASSEMBLIES"))
+                        .Split(Path.PathSeparator)
+                        .Append(typeof(SharpGen.Runtime.CppObject).Assembly.Location)
+                        .Distinct()
+                        .Select(x => MetadataReference.CreateFromFile(x));
+
+        var compilation = CSharpCompilation.Create(
+            GetType().Name,
+            new[] { CSharpSyntaxTree.ParseText(code) },
+            references,
+            new CSharpCompilationOptions(OutputKind.DynamicallyLinkedLibrary, allowUnsafe: true)
+        );
+
+        Assert.Empty(compilation.GetDiagnostics().Where(x => x.Severity == DiagnosticSeverity.Error));
+    }
+
     private TransformManager CreateTransformer()
     {
         NamingRulesManager namingRules = new();
@@ -0,0 +1,108 @@
+using System.Collections.Generic;
+using System.IO;
+using SharpGen.Config;
+using SharpGen.Parser;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace SharpGen.UnitTests.Parsing;
+
+public class CastXmlShardTests : FileSystemTestBase
+{
+    public CastXmlShardTests(ITestOutputHelper outputHelper) : base(outputHelper)
+    {
+    }
+
+    [Fact]
+    public void EachConfigWithIncludesGetsItsOwnShard()
+    {
+        var child = new ConfigFile
+        {
+            Id = "Child",
+            Includes = { new IncludeRule { File = "child.h" } },
+            Extension = { new CreateExtensionRule { NewClass = "Child.Functions" } }
+        };
+
+        var root = new ConfigFile
+        {
+            Id = "Root",
+            Includes = { new IncludeRule { File = "root.h" } },
+            References = { child }
+        };
+
+        var empty = new ConfigFile { Id = "Empty" };
+
+        CppHeaderGenerator generator = new(TestDirectory.FullName, Ioc);
+        var shards = generator.GenerateShardHeaders(
+            new[] { root, child, empty }, new HashSet<ConfigFile> { child }, "#define PROLOGUE\n"
+        );
+
+        Assert.Equal(2, shards.Count);
+
+        Assert.Equal(Path.Combine(TestDirectory.FullName, "Root-shard.h"), shards[0].HeaderFile);
+        Assert.Equal(new HashSet<string> { "root" }, shards[0].IncludeIds);
+
+        Assert.Equal(Path.Combine(TestDirectory.FullName, "Child-shard.h"), shards[1].HeaderFile);
+        Assert.Equal(new HashSet<string> { "child", child.ExtensionId }, shards[1].IncludeIds);
+        Assert.True(shards[1].IncludeIds.Contains("CHILD"));
+
+        // The root shard pulls the includes of the child config, but only owns its own includes
+        var rootShardHeader = File.ReadAllText(shards[0].HeaderFile);
+        Assert.Contains("#define PROLOGUE", rootShardHeader);
+        Assert.Contains("#include \"root.h\"", rootShardHeader);
+        Assert.Contains("#include \"child.h\"", rootShardHeader);
+        Assert.Contains($"#include \"{child.ExtensionFileName}\"", rootShardHeader);
+        Assert.DoesNotContain(child.HeaderFileName, rootShardHeader);
+
+        var childShardHeader = File.ReadAllText(shards[1].HeaderFile);
+        Assert.Contains("#define PROLOGUE", childShardHeader);
+        Assert.Contains("#include \"child.h\"", childShardHeader);
+        Assert.Contains($"#include \"{child.ExtensionFileName}\"", childShardHeader);
+        Assert.DoesNotContain(child.HeaderFileName, childShardHeader);
+        Assert.DoesNotContain("root.h", childShardHeader);
+    }
+
+    [Fact]
+    public void ShardIncludesReferencedConfigsBeforeItsOwnIncludes()
+    {
+        var common = new ConfigFile
+        {
+            Id = "Common",
+            Includes = { new IncludeRule { File = "common.h", Pre = "#define COMMON_PRE", Post = "#undef COMMON_PRE" } }
+        };
+
+        var types = new ConfigFile
+        {
+            Id = "Types",
+            Includes = { new IncludeRule { File = "types.h" } },
+            References = { common }
+        };
+
+        var functions = new ConfigFile
+        {
+            Id = "Functions",
+            Includes = { new IncludeRule { File = "functions.h" } },
+            References = { types, common }
+        };
+
+        CppHeaderGenerator generator = new(TestDirectory.FullName, Ioc);
+        var shards = generator.GenerateShardHeaders(
+            new[] { functions, types, common }, new HashSet<ConfigFile>(), "#define PROLOGUE\n"
+        );
+
+        Assert.Equal(3, shards.Count);
+        Assert.Equal(new HashSet<string> { "functions" }, shards[0].IncludeIds);
+
+        var functionsShardHeader = File.ReadAllText(shards[0].HeaderFile).Replace("\r\n", "\n");
+        Assert.Contains(
+            "#define PROLOGUE\n" +
+            "#define COMMON_PRE\n#include \"common.h\"\n#undef COMMON_PRE\n" +
+            "#include \"types.h\"\n" +
+            "#include \"functions.h\"\n",
+            functionsShardHeader
+        );
+
+        // The headers of a config file referenced several times are included once
+        Assert.Equal(functionsShardHeader.IndexOf("common.h"), functionsShardHeader.LastIndexOf("common.h"));
+    }
+}
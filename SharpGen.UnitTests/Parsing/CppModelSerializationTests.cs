@@ -0,0 +1,114 @@
+using System;
+using System.IO;
+using System.Linq;
+using System.Runtime.InteropServices;
+using SharpGen.Config;
+using SharpGen.CppModel;
+using Xunit;
+
+namespace SharpGen.UnitTests.Parsing;
+
+public class CppModelSerializationTests
+{
+    private static CppInclude RoundTrip(CppInclude include)
+    {
+        using MemoryStream stream = new();
+
+        using (CppModelWriter writer = new(stream, true))
+            writer.WriteElement(include);
+
+        stream.Position = 0;
+
+        using CppModelReader reader = new(stream);
+        return Assert.IsType<CppInclude>(reader.ReadElement());
+    }
+
+    [Fact]
+    public void InterfaceRoundTrips()
+    {
+        var method = new CppMethod("Method")
+        {
+            Offset = 3,
+            WindowsOffset = 4,
+            CallingConvention = CallingConvention.StdCall,
+            ReturnValue = new CppReturnValue { TypeName = "int" }
+        };
+        method.Add(new CppParameter("param") { TypeName = "void", Pointer = "**", Attribute = ParamAttribute.Out });
+
+        var cppInterface = new CppInterface("Interface")
+        {
+            Guid = "ABCDEF01-2345-6789-ABCD-EF0123456789",
+            Base = "IUnknown",
+            TotalMethodCount = 4
+        };
+        cppInterface.Add(method);
+
+        var include = new CppInclude("test");
+        include.Add(cppInterface);
+
+        var result = RoundTrip(include);
+
+        Assert.Equal("test", result.Name);
+        var resultInterface = Assert.IsType<CppInterface>(Assert.Single(result.Items));
+        Assert.Same(result, resultInterface.Parent);
+        Assert.Equal(cppInterface.Guid, resultInterface.Guid);
+        Assert.Equal(cppInterface.Base, resultInterface.Base);
+        Assert.Equal(4, resultInterface.TotalMethodCount);
+
+        var resultMethod = Assert.Single(resultInterface.Methods);
+        Assert.Equal(3, resultMethod.Offset);
+        Assert.Equal(4, resultMethod.WindowsOffset);
+        Assert.Equal(CallingConvention.StdCall, resultMethod.CallingConvention);
+        Assert.Equal("int", resultMethod.ReturnValue.TypeName);
+        Assert.Equal(string.Empty, resultMethod.ReturnValue.Pointer);
+
+        var resultParameter = Assert.Single(resultMethod.Parameters);
+        Assert.Equal("param", resultParameter.Name);
+        Assert.Equal("void", resultParameter.TypeName);
+        Assert.Equal("**", resultParameter.Pointer);
+        Assert.Equal(ParamAttribute.Out, resultParameter.Attribute);
+    }
+
+    [Fact]
+    public void StructEnumAndConstantsRoundTrip()
+    {
+        var cppStruct = new CppStruct("Struct") { IsUnion = true };
+        cppStruct.Add(new CppField("field") { TypeName = "char", ArrayDimension = "16", IsBitField = true, BitOffset = 2, Offset = 1 });
+
+        var cppEnum = new CppEnum("Enum") { UnderlyingType = "short" };
+        cppEnum.AddEnumItem("ENUM_A", "0");
+        cppEnum.AddEnumItem("ENUM_B", "0");
+
+        var guid = Guid.NewGuid();
+
+        var include = new CppInclude("test");
+        include.Add(cppStruct);
+        include.Add(cppEnum);
+        include.Add(new CppConstant("Constant", "int", "42"));
+        include.Add(new CppGuid("IID_Test", guid));
+        include.Add(new CppDefine("MACRO", "1"));
+
+        var result = RoundTrip(include);
+
+        var resultStruct = Assert.IsType<CppStruct>(result.Items[0]);
+        Assert.True(resultStruct.IsUnion);
+        var resultField = Assert.Single(resultStruct.Fields);
+        Assert.Equal("char", resultField.TypeName);
+        Assert.Equal("16", resultField.ArrayDimension);
+        Assert.True(resultField.IsBitField);
+        Assert.Equal(2, resultField.BitOffset);
+        Assert.Equal(1, resultField.Offset);
+
+        var resultEnum = Assert.IsType<CppEnum>(result.Items[1]);
+        Assert.Equal("short", resultEnum.UnderlyingType);
+        Assert.Equal(new[] { "ENUM_A", "ENUM_B" }, resultEnum.EnumItems.Select(x => x.Name));
+        Assert.All(resultEnum.EnumItems, x => Assert.Equal("0", x.Value));
+
+        var resultConstant = Assert.IsType<CppConstant>(result.Items[2]);
+        Assert.Equal("int", resultConstant.TypeName);
+        Assert.Equal("42", resultConstant.Value);
+
+        Assert.Equal(guid, Assert.IsType<CppGuid>(result.Items[3]).Guid);
+        Assert.Equal("1", Assert.IsType<CppDefine>(result.Items[4]).Value);
+    }
+}
@@ -43,4 +43,45 @@ public class MacroManagerTests : ParsingTestBase
 
         Assert.Contains(includeRule.Path + "/included.h", macroManager.IncludedFiles);
     }
-}
\ No newline at end of file
+
+    [Fact]
+    public void MacroManagerKeepsPreprocessedTranslationUnit()
+    {
+        var includeRule = GetTestFileIncludeRule();
+
+        var config = new ConfigFile
+        {
+            Id = nameof(MacroManagerKeepsPreprocessedTranslationUnit),
+            Namespace = nameof(MacroManagerKeepsPreprocessedTranslationUnit),
+            IncludeDirs = { includeRule },
+            Includes =
+            {
+                CreateCppFile("preprocessed", @"
+#define VALUE 1
+#ifndef __SHARPGEN_PREPROCESS_ONLY__
+struct Excluded {};
+#endif
+struct Kept { int field[VALUE]; };
+")
+            }
+        };
+
+        config.Load(null, Array.Empty<string>(), Logger);
+
+        var castXml = GetCastXml(config);
+
+        var macroManager = new MacroManager(castXml);
+        var module = new CppModule("SharpGenTestModule");
+        var preprocessedFile = Path.Combine(TestDirectory.FullName, "preprocessed.ii");
+
+        macroManager.Parse(Path.Combine(includeRule.Path, "preprocessed.h"), preprocessedFile, module);
+
+        Assert.Equal("1", Assert.Single(module.FindInclude("preprocessed").Macros).Value);
+
+        var preprocessed = File.ReadAllText(preprocessedFile);
+        Assert.Contains("#define VALUE 1", preprocessed);
+        Assert.Contains("struct Kept { int field[1]; };", preprocessed);
+        Assert.DoesNotContain("Excluded", preprocessed);
+        Assert.DoesNotContain(CppHeaderGenerator.PreprocessOnlyMacro, preprocessed);
+    }
+}
@@ -0,0 +1,131 @@
+using System.Collections.Generic;
+using System.IO;
+using SharpGen.Config;
+using SharpGen.Parser;
+using SharpGen.Platform;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace SharpGen.UnitTests.Parsing;
+
+public class PrecompiledHeaderTests : FileSystemTestBase
+{
+    public PrecompiledHeaderTests(ITestOutputHelper outputHelper) : base(outputHelper)
+    {
+    }
+
+    private static bool IsSystemInclude(string file) => file.StartsWith("sdk");
+
+    [Fact]
+    public void LeadingSystemIncludesArePrecompiled()
+    {
+        var sdk = new ConfigFile
+        {
+            Id = "Sdk",
+            Includes = { new IncludeRule { File = "sdk1.h" }, new IncludeRule { File = "sdk2.h" } }
+        };
+
+        var root = new ConfigFile
+        {
+            Id = "Root",
+            Includes = { new IncludeRule { File = "sdk0.h" } },
+            References = { sdk, new ConfigFile { Id = "Project", Includes = { new IncludeRule { File = "project.h" } } } }
+        };
+
+        root.References.Add(sdk);
+
+        CppHeaderGenerator generator = new(TestDirectory.FullName, Ioc);
+        var header = generator.GeneratePrecompiledHeader(
+            root, new[] { root, sdk, root.References[1] }, new HashSet<ConfigFile>(), "#define PROLOGUE\n",
+            IsSystemInclude
+        );
+
+        Assert.Equal(Path.Combine(TestDirectory.FullName, "Root-pch.h"), header);
+
+        var contents = File.ReadAllLines(header);
+        Assert.Equal(
+            new[] { "#define PROLOGUE", "#include \"sdk0.h\"", "#include \"sdk1.h\"", "#include \"sdk2.h\"" },
+            contents[1..]
+        );
+    }
+
+    [Fact]
+    public void IncludesWithCustomCodeOrExtensionHeaderEndThePrecompiledHeader()
+    {
+        var withExtension = new ConfigFile
+        {
+            Id = "Extension",
+            Includes = { new IncludeRule { File = "sdk1.h" } }
+        };
+
+        var root = new ConfigFile
+        {
+            Id = "Root",
+            Includes =
+            {
+                new IncludeRule { File = "sdk0.h" },
+                new IncludeRule { File = "sdk2.h", Pre = "#define BEFORE_SDK2" }
+            },
+            References = { withExtension }
+        };
+
+        CppHeaderGenerator generator = new(TestDirectory.FullName, Ioc);
+
+        var header = generator.GeneratePrecompiledHeader(
+            root, new[] { root, withExtension }, new HashSet<ConfigFile>(), "", IsSystemInclude
+        );
+        Assert.DoesNotContain("sdk2.h", File.ReadAllText(header));
+
+        root.Includes.RemoveAt(1);
+        header = generator.GeneratePrecompiledHeader(
+            root, new[] { root, withExtension }, new HashSet<ConfigFile> { withExtension }, "", IsSystemInclude
+        );
+        Assert.Contains("#include \"sdk1.h\"", File.ReadAllText(header));
+
+        var after = new ConfigFile { Id = "After", Includes = { new IncludeRule { File = "sdk3.h" } } };
+        root.References.Add(after);
+        header = generator.GeneratePrecompiledHeader(
+            root, new[] { root, withExtension, after }, new HashSet<ConfigFile> { withExtension }, "", IsSystemInclude
+        );
+        Assert.Contains("#include \"sdk1.h\"", File.ReadAllText(header));
+        Assert.DoesNotContain("sdk3.h", File.ReadAllText(header));
+    }
+
+    [Fact]
+    public void NoPrecompiledHeaderWithoutLeadingSystemInclude()
+    {
+        var root = new ConfigFile
+        {
+            Id = "Root",
+            Includes = { new IncludeRule { File = "project.h" }, new IncludeRule { File = "sdk.h" } }
+        };
+
+        CppHeaderGenerator generator = new(TestDirectory.FullName, Ioc);
+
+        Assert.Null(
+            generator.GeneratePrecompiledHeader(root, new[] { root }, new HashSet<ConfigFile>(), "", IsSystemInclude)
+        );
+    }
+
+    [Fact]
+    public void OverrideDirectoriesHideSystemIncludes()
+    {
+        var system = TestDirectory.CreateSubdirectory("System");
+        var project = TestDirectory.CreateSubdirectory("Project");
+        File.WriteAllText(Path.Combine(system.FullName, "system.h"), "");
+        File.WriteAllText(Path.Combine(system.FullName, "shadowed.h"), "");
+        File.WriteAllText(Path.Combine(project.FullName, "shadowed.h"), "");
+        File.WriteAllText(Path.Combine(project.FullName, "project.h"), "");
+
+        IncludeDirectoryResolver resolver = new(Ioc);
+        resolver.AddDirectories(
+            new IncludeDirRule(system.FullName),
+            new IncludeDirRule(project.FullName) { IsOverride = true }
+        );
+
+        Assert.True(resolver.IsSystemInclude("system.h"));
+        Assert.False(resolver.IsSystemInclude("shadowed.h"));
+        Assert.False(resolver.IsSystemInclude("project.h"));
+        Assert.False(resolver.IsSystemInclude("missing.h"));
+    }
+}
@@ -0,0 +1,64 @@
+using System.IO;
+using System.Linq;
+using System.Text.Json;
+using System.Threading.Tasks;
+using SharpGen.Logging;
+using Xunit;
+
+namespace SharpGen.UnitTests;
+
+public class PhaseTraceTests
+{
+    [Fact]
+    public void PhasesAreRecordedAsChromeTraceEvents()
+    {
+        TraceRecorder recorder = new();
+        PhaseTrace.Recorder = recorder;
+
+        try
+        {
+            using (PhaseTrace.Begin("Outer"))
+            {
+                using (PhaseTrace.Begin("Inner \"quoted\""))
+                {
+                }
+
+                Parallel.For(0, 4, i =>
+                {
+                    using var phase = PhaseTrace.Begin($"Worker {i}");
+                });
+            }
+        }
+        finally
+        {
+            PhaseTrace.Recorder = null;
+        }
+
+        using (PhaseTrace.Begin("Not recorded"))
+        {
+        }
+
+        StringWriter writer = new();
+        recorder.WriteChromeTrace(writer);
+
+        using var document = JsonDocument.Parse(writer.ToString());
+        var events = document.RootElement.GetProperty("traceEvents").EnumerateArray().ToArray();
+
+        Assert.Equal(
+            new[] { "Inner \"quoted\"", "Outer", "Worker 0", "Worker 1", "Worker 2", "Worker 3" },
+            events.Select(x => x.GetProperty("name").GetString()).OrderBy(x => x, System.StringComparer.Ordinal)
+        );
+
+        Assert.All(events, x => Assert.Equal("X", x.GetProperty("ph").GetString()));
+
+        var outer = events.Single(x => x.GetProperty("name").GetString() == "Outer");
+        var outerStart = outer.GetProperty("ts").GetDouble();
+        var outerEnd = outerStart + outer.GetProperty("dur").GetDouble();
+
+        Assert.Equal("Outer", events[0].GetProperty("name").GetString());
+        Assert.All(
+            events.Skip(1),
+            x => Assert.InRange(x.GetProperty("ts").GetDouble(), outerStart, outerEnd)
+        );
+    }
+}
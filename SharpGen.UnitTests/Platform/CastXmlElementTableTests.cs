@@ -0,0 +1,73 @@
+using System.Collections.Generic;
+using System.IO;
+using SharpGen.Platform;
+using Xunit;
+
+namespace SharpGen.UnitTests.Platform;
+
+public class CastXmlElementTableTests
+{
+    private const string Document = @"<?xml version=""1.0""?>
+<GCC_XML version=""0.9.0"" cvs_revision=""1.139"">
+  <Namespace id=""_1"" name=""::"" members=""_2 _3""/>
+  <Struct id=""_2"" name=""Foo"" context=""_1"" file=""f1"" size=""64"" incomplete=""1""/>
+  <Field id=""_4"" name=""bar"" type=""_5"" context=""_2"" file=""f1""/>
+  <Function id=""_3"" name=""Baz"" returns=""_5"" context=""_1"" file=""f1"">
+    <Argument name=""x"" type=""_5""/>
+    <Argument name=""y"" type=""_5""/>
+  </Function>
+  <FundamentalType id=""_5"" name=""int"" size=""32""/>
+  <File id=""f1"" name=""test.h""/>
+</GCC_XML>";
+
+    private static CastXmlElementTable Load() => CastXmlElementTable.Load(new StringReader(Document));
+
+    [Fact]
+    public void ElementsAreAddressableById()
+    {
+        var table = Load();
+
+        var foo = table["_2"];
+        Assert.Equal("Struct", table.Tag(foo));
+        Assert.Equal("Foo", table.Name(foo));
+        Assert.Equal("64", table.Attribute(foo, "size"));
+        Assert.Equal("1", table.Attribute(foo, "incomplete"));
+        Assert.Null(table.Attribute(foo, "members"));
+        Assert.Throws<KeyNotFoundException>(() => table["_42"]);
+    }
+
+    [Fact]
+    public void ContextIsResolved()
+    {
+        var table = Load();
+
+        Assert.Equal(table["_2"], table.Context(table["_4"]));
+        Assert.Equal(CastXmlElementTable.NoElement, table.Context(table["_1"]));
+    }
+
+    [Fact]
+    public void ChildrenIncludeNestedAndContextElementsInOrder()
+    {
+        var table = Load();
+
+        var arguments = new List<string>();
+        foreach (var child in table.Children(table["_3"]))
+            arguments.Add(table.Name(child));
+
+        Assert.Equal(new[] { "x", "y" }, arguments);
+
+        var members = new List<string>();
+        foreach (var child in table.Children(table["_1"]))
+            members.Add(table.Id(child));
+
+        Assert.Equal(new[] { "_2", "_3" }, members);
+    }
+
+    [Fact]
+    public void TopLevelElementsAreGroupedByFile()
+    {
+        var table = Load();
+
+        Assert.Equal(new[] { table["_2"], table["_4"], table["_3"] }, table.FileElements["f1"]);
+    }
+}
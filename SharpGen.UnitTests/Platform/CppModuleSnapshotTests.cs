@@ -0,0 +1,100 @@
+using System.IO;
+using SharpGen.CppModel;
+using SharpGen.Platform;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace SharpGen.UnitTests.Platform;
+
+public class CppModuleSnapshotTests : FileSystemTestBase
+{
+    public CppModuleSnapshotTests(ITestOutputHelper outputHelper) : base(outputHelper)
+    {
+    }
+
+    private string SnapshotPath => Path.Combine(TestDirectory.FullName, "Module.cppmodel");
+
+    private string CreateInput(string name, string contents)
+    {
+        var path = Path.Combine(TestDirectory.FullName, name);
+        File.WriteAllText(path, contents);
+        return path;
+    }
+
+    private static CppModule CreateModule()
+    {
+        var include = new CppInclude("test");
+        include.Add(new CppDefine("MACRO", "1"));
+        include.Add(new CppStruct("Struct"));
+
+        var module = new CppModule("Module");
+        module.Add(include);
+        return module;
+    }
+
+    [Fact]
+    public void SnapshotIsLoadedWhenInputsAreUnchanged()
+    {
+        var header = CreateInput("test.h", "struct Struct {};");
+        var generated = CreateInput("Module.h", "#include \"test.h\"");
+
+        new CppModuleSnapshot(SnapshotPath, "config", Ioc).Save(CreateModule(), new[] { generated }, new[] { header });
+
+        var snapshot = new CppModuleSnapshot(SnapshotPath, "config", Ioc);
+        var module = snapshot.TryLoad();
+
+        Assert.NotNull(module);
+        Assert.Equal("Module", module.Name);
+        var include = Assert.Single(module.Includes);
+        Assert.Same(module, include.Parent);
+        Assert.Equal("MACRO", Assert.Single(include.Macros).Name);
+        Assert.Equal("Struct", Assert.Single(include.Iterate<CppStruct>()).Name);
+        Assert.Equal(new[] { header }, snapshot.IncludedFiles);
+    }
+
+    [Fact]
+    public void SnapshotIsInvalidatedByInputChange()
+    {
+        var header = CreateInput("test.h", "struct Struct {};");
+
+        new CppModuleSnapshot(SnapshotPath, "config", Ioc).Save(CreateModule(), new string[0], new[] { header });
+
+        File.WriteAllText(header, "struct Struct { int field; };");
+
+        Assert.Null(new CppModuleSnapshot(SnapshotPath, "config", Ioc).TryLoad());
+    }
+
+    [Fact]
+    public void SnapshotIsInvalidatedByConfigurationChange()
+    {
+        var header = CreateInput("test.h", "struct Struct {};");
+
+        new CppModuleSnapshot(SnapshotPath, "config", Ioc).Save(CreateModule(), new string[0], new[] { header });
+
+        Assert.Null(new CppModuleSnapshot(SnapshotPath, "other config", Ioc).TryLoad());
+    }
+
+    [Fact]
+    public void SnapshotIsInvalidatedByCastXmlArgumentChange()
+    {
+        var header = CreateInput("test.h", "struct Struct {};");
+
+        string GetKey(params string[] arguments) =>
+            new CastXmlRunner(new IncludeDirectoryResolver(Ioc), "castxml", arguments, Ioc).ConfigurationKey;
+
+        new CppModuleSnapshot(SnapshotPath, GetKey("-std=c++14"), Ioc).Save(CreateModule(), new string[0], new[] { header });
+
+        Assert.NotNull(new CppModuleSnapshot(SnapshotPath, GetKey("-std=c++14"), Ioc).TryLoad());
+        Assert.Null(new CppModuleSnapshot(SnapshotPath, GetKey("-std=c++17"), Ioc).TryLoad());
+    }
+
+    [Fact]
+    public void SnapshotIsNotSavedWithMissingInput()
+    {
+        var missing = Path.Combine(TestDirectory.FullName, "missing.h");
+
+        new CppModuleSnapshot(SnapshotPath, "config", Ioc).Save(CreateModule(), new[] { missing }, new string[0]);
+
+        Assert.False(File.Exists(SnapshotPath));
+    }
+}
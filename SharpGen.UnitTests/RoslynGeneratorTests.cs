@@ -1,5 +1,6 @@
 using System;
 using System.Collections.Generic;
+using System.Linq;
 using System.Xml;
 using Microsoft.CodeAnalysis.CSharp;
 using SharpGen.Generator;
@@ -50,6 +51,35 @@ public class RoslynGeneratorTests : TestBase
         );
     }
 
+    [Fact]
+    public void NamespacesAreGeneratedInSeparateTrees()
+    {
+        CsAssembly assembly = new();
+        foreach (var name in new[] { "First", "Second", "Third" })
+        {
+            CsNamespace @namespace = new(name);
+            @namespace.Add(new CsStruct(null, "Struct" + name));
+            assembly.Add(@namespace);
+        }
+
+        AddIocServices(CreateExternalDocCommentsReader(new XmlDocument()));
+        AddIocServices(CreateDefaultGenerators());
+
+        var trees = new RoslynGenerator().RunPerNamespace(assembly, Ioc, 2);
+
+        Assert.Equal(new[] { "First", "Second", "Third" }, trees.Select(x => x.Namespace));
+        Assert.All(
+            trees,
+            x =>
+            {
+                var text = x.Tree.GetCompilationUnitRoot().ToFullString();
+                Assert.StartsWith("// <auto-generated/>", text);
+                Assert.Contains($"namespace {x.Namespace}", text);
+                Assert.Contains($"public partial struct Struct{x.Namespace}", text);
+            }
+        );
+    }
+
     private static Action<IocServiceContainer> CreateExternalDocCommentsReader(XmlDocument docs)
     {
         return container =>
@@ -0,0 +1,113 @@
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+using System.Threading;
+using System.Threading.Tasks;
+using SharpGen.Runtime;
+using Xunit;
+
+namespace SharpGen.UnitTests.Runtime;
+
+public unsafe class CppObjectIdentityCacheTests : IDisposable
+{
+    // A native object implementing IUnknown::Release only, and counting the calls
+    private readonly IntPtr* nativeObject;
+
+    public CppObjectIdentityCacheTests()
+    {
+        nativeObject = (IntPtr*) Marshal.AllocHGlobal(2 * IntPtr.Size);
+
+        var vtbl = (IntPtr*) Marshal.AllocHGlobal(3 * IntPtr.Size);
+        vtbl[2] = (IntPtr) (delegate* unmanaged[Stdcall]<IntPtr, uint>) &Release;
+
+        nativeObject[0] = (IntPtr) vtbl;
+        nativeObject[1] = IntPtr.Zero;
+    }
+
+    public void Dispose()
+    {
+        Marshal.FreeHGlobal(nativeObject[0]);
+        Marshal.FreeHGlobal((IntPtr) nativeObject);
+    }
+
+    private IntPtr Pointer => (IntPtr) nativeObject;
+
+    private int ReleaseCount => (int) nativeObject[1];
+
+    [UnmanagedCallersOnly(CallConvs = new[] { typeof(CallConvStdcall) })]
+    private static uint Release(IntPtr thisObject)
+    {
+        Interlocked.Increment(ref *(int*) ((IntPtr*) thisObject + 1));
+        return 1;
+    }
+
+    [Fact]
+    public void LiveWrapperIsReturnedAndOwnsASingleReference()
+    {
+        var first = MarshallingHelpers.FromPointerCached(Pointer, static x => new ComObject(x));
+        var second = MarshallingHelpers.FromPointerCached(Pointer, static x => new ComObject(x));
+
+        Assert.Same(first, second);
+        Assert.Equal(1, ReleaseCount);
+
+        first.Dispose();
+        Assert.Equal(2, ReleaseCount);
+    }
+
+    [Fact]
+    public void DisposedWrapperIsReplaced()
+    {
+        var first = MarshallingHelpers.FromPointerCached(Pointer, static x => new ComObject(x));
+        first.Dispose();
+
+        var second = MarshallingHelpers.FromPointerCached(Pointer, static x => new ComObject(x));
+
+        Assert.NotSame(first, second);
+        Assert.Equal(Pointer, second.NativePointer);
+        Assert.Equal(1, ReleaseCount);
+
+        second.Dispose();
+    }
+
+    [Fact]
+    public void ConcurrentDisposeReleasesEveryReferenceOnce()
+    {
+        const int iterations = 10000;
+
+        List<ComObject> wrappers = new(iterations);
+        ComObject latest = null;
+        var done = false;
+
+        var disposer = Task.Run(() =>
+        {
+            while (!Volatile.Read(ref done))
+                Volatile.Read(ref latest)?.Dispose();
+        });
+
+        for (var i = 0; i < iterations; i++)
+        {
+            var wrapper = MarshallingHelpers.FromPointerCached(Pointer, static x => new ComObject(x));
+            wrappers.Add(wrapper);
+            Volatile.Write(ref latest, wrapper);
+        }
+
+        Volatile.Write(ref done, true);
+        disposer.Wait();
+
+        foreach (var wrapper in wrappers)
+            wrapper.Dispose();
+
+        Assert.Equal(iterations, ReleaseCount);
+    }
+
+    [Fact]
+    public void NonComWrappersAreNotCached()
+    {
+        var first = MarshallingHelpers.FromPointerCached(Pointer, static x => new CppObject(x));
+        var second = MarshallingHelpers.FromPointerCached(Pointer, static x => new CppObject(x));
+
+        Assert.NotSame(first, second);
+        Assert.Equal(0, ReleaseCount);
+    }
+}
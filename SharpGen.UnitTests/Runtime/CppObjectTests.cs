@@ -22,4 +22,31 @@ public class CppObjectTests
         Assert.NotEqual(IntPtr.Zero, MarshallingHelpers.ToCallbackPtr<ICallback>(callback));
         Assert.NotEqual(IntPtr.Zero, MarshallingHelpers.ToCallbackPtr<ICallback2>(callback));
     }
+
+    [Fact]
+    public void FromPointerUsesRegisteredFactory()
+    {
+        TypeDataStorage.Storage<FactoryObject>.Factory = static x => new FactoryObject(x, true);
+
+        var result = MarshallingHelpers.FromPointer<FactoryObject>(new IntPtr(1));
+
+        Assert.NotNull(result);
+        Assert.True(result.FromFactory);
+        Assert.Equal(new IntPtr(1), result.NativePointer);
+        Assert.Null(MarshallingHelpers.FromPointer<FactoryObject>(IntPtr.Zero));
+    }
+
+    private sealed class FactoryObject : CppObject
+    {
+        public FactoryObject(IntPtr pointer) : base(pointer)
+        {
+        }
+
+        public FactoryObject(IntPtr pointer, bool fromFactory) : base(pointer)
+        {
+            FromFactory = fromFactory;
+        }
+
+        public bool FromFactory { get; }
+    }
 }
\ No newline at end of file
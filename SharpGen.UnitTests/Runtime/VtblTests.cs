@@ -19,4 +19,17 @@ public class VtblTests
         var delegateObject = Marshal.GetDelegateForFunctionPointer<CallbackVtbl.IncrementDelegate>(methodPtr);
         Assert.Equal(3, delegateObject(callbackPtr, 2));
     }
+
+    [Fact]
+    public void InheritedVtblIsLaidOutBeforeDerivedVtbl()
+    {
+        using var callback = new Callback2Impl();
+
+        var callbackPtr = MarshallingHelpers.ToCallbackPtr<ICallback2>(callback);
+        Assert.NotEqual(IntPtr.Zero, callbackPtr);
+
+        var vtbl = Marshal.ReadIntPtr(callbackPtr);
+        Assert.Equal(CallbackVtbl.Vtbl[0], Marshal.ReadIntPtr(vtbl));
+        Assert.Equal(Callback2Vtbl.Vtbl[0], Marshal.ReadIntPtr(vtbl, IntPtr.Size));
+    }
 }
\ No newline at end of file
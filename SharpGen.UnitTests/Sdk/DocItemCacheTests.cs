@@ -0,0 +1,137 @@
+using System.IO;
+using System.Linq;
+using SharpGen.Platform.Documentation;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace SharpGen.UnitTests.Sdk;
+
+public class DocItemCacheTests : FileSystemTestBase
+{
+    public DocItemCacheTests(ITestOutputHelper outputHelper) : base(outputHelper)
+    {
+    }
+
+    private string CacheFile => Path.Combine(TestDirectory.FullName, "DocumentationCache.json");
+
+    private static DocItem CreateItem(string summary, params string[] names)
+    {
+        var item = new DocItem { Summary = summary };
+        foreach (var name in names)
+            item.Names.Add(name);
+        return item;
+    }
+
+    [Fact]
+    public void FindByAnyNameIgnoringCase()
+    {
+        var cache = new DocItemCache();
+        var first = CreateItem("First", "IFirst", "IFirst::Method");
+        var duplicate = CreateItem("Duplicate", "IFIRST");
+
+        cache.Add(first);
+        cache.Add(duplicate);
+
+        Assert.Same(first, cache.Find("IFirst"));
+        Assert.Same(first, cache.Find("ifirst::method"));
+        Assert.Null(cache.Find("ISecond"));
+    }
+
+    [Fact]
+    public void WrittenCacheIsReadBack()
+    {
+        var cache = new DocItemCache();
+        cache.Add(CreateItem("First", "IFirst"));
+        cache.Add(CreateItem("Second", "ISecond"));
+
+        cache.WriteIfDirty(CacheFile);
+
+        var readCache = DocItemCache.Read(CacheFile);
+
+        Assert.Equal(new[] { "First", "Second" }, readCache.DocItems.Select(x => x.Summary));
+        Assert.Equal("Second", readCache.Find("ISecond").Summary);
+        Assert.All(readCache.DocItems, x => Assert.False(x.IsDirty));
+    }
+
+    [Fact]
+    public void OnlyChangedItemsAreAppended()
+    {
+        var cache = new DocItemCache();
+        cache.Add(CreateItem("First", "IFirst"));
+        cache.Add(CreateItem("Second", "ISecond"));
+        cache.Add(CreateItem("Third", "IThird"));
+        cache.WriteIfDirty(CacheFile);
+
+        cache = DocItemCache.Read(CacheFile);
+        cache.Find("ISecond").Summary = "Second (updated)";
+        cache.Add(CreateItem("Fourth", "IFourth"));
+        cache.WriteIfDirty(CacheFile);
+
+        Assert.Equal(5, File.ReadAllLines(CacheFile).Length);
+
+        var readCache = DocItemCache.Read(CacheFile);
+
+        Assert.Equal(
+            new[] { "First", "Second (updated)", "Third", "Fourth" },
+            readCache.DocItems.Select(x => x.Summary)
+        );
+
+        var length = new FileInfo(CacheFile).Length;
+        readCache.WriteIfDirty(CacheFile);
+        Assert.Equal(length, new FileInfo(CacheFile).Length);
+    }
+
+    [Fact]
+    public void SupersededLinesAreCompacted()
+    {
+        var cache = new DocItemCache();
+        cache.Add(CreateItem("Item", "IItem"));
+        cache.WriteIfDirty(CacheFile);
+
+        for (var i = 0; i < 3; i++)
+        {
+            cache.Find("IItem").Summary = $"Item {i}";
+            cache.WriteIfDirty(CacheFile);
+        }
+
+        Assert.True(File.ReadAllLines(CacheFile).Length <= 2);
+        Assert.Equal("Item 2", DocItemCache.Read(CacheFile).Find("IItem").Summary);
+    }
+
+    [Fact]
+    public void LegacyCacheIsReadAndRewritten()
+    {
+        File.WriteAllText(
+            CacheFile,
+            @"{""DocItems"":[{""ShortId"":""Id"",""Names"":[""ILegacy""],""Summary"":""Legacy"",""Remarks"":null,""Return"":null,""Items"":[],""SeeAlso"":[]}]}"
+        );
+
+        var cache = DocItemCache.Read(CacheFile);
+
+        Assert.Equal("Legacy", cache.Find("ILegacy").Summary);
+
+        cache.WriteIfDirty(CacheFile);
+
+        Assert.Equal("Legacy", DocItemCache.Read(CacheFile).Find("ILegacy").Summary);
+        Assert.StartsWith(@"{""Index"":0,", File.ReadAllText(CacheFile));
+    }
+
+    [Fact]
+    public void InterruptedAppendIsIgnored()
+    {
+        var cache = new DocItemCache();
+        cache.Add(CreateItem("First", "IFirst"));
+        cache.WriteIfDirty(CacheFile);
+
+        File.AppendAllText(CacheFile, @"{""Index"":1,""Item"":{""ShortId");
+
+        var readCache = DocItemCache.Read(CacheFile);
+
+        Assert.Equal("First", Assert.Single(readCache.DocItems).Summary);
+
+        readCache.Add(CreateItem("Second", "ISecond"));
+        readCache.WriteIfDirty(CacheFile);
+
+        Assert.Equal(2, DocItemCache.Read(CacheFile).DocItems.Count);
+    }
+}
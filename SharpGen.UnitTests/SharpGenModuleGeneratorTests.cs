@@ -0,0 +1,178 @@
+using System;
+using System.IO;
+using System.Linq;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using SharpGen.Generator;
+using Xunit;
+
+namespace SharpGen.UnitTests;
+
+public class SharpGenModuleGeneratorTests
+{
+    private const string BindingSource = @"
+using System;
+using System.Runtime.InteropServices;
+using SharpGen.Runtime;
+
+namespace Binding
+{
+    internal static class BaseVtbl
+    {
+        public static readonly IntPtr[] Vtbl = new IntPtr[1];
+    }
+
+    internal static class DerivedVtbl
+    {
+        public static readonly IntPtr[] Vtbl = new IntPtr[1];
+    }
+
+    [Vtbl(typeof(BaseVtbl)), Guid(""11111111-1111-1111-1111-111111111111"")]
+    public interface IBase : IUnknown
+    {
+    }
+
+    [Vtbl(typeof(DerivedVtbl)), Guid(""22222222-2222-2222-2222-222222222222"")]
+    public interface IDerived : IBase
+    {
+    }
+}
+";
+
+    [Fact]
+    public void ForeignInterfacesWithInternalVtblAreNotComposed()
+    {
+        var binding = CreateCompilation("Binding", BindingSource);
+
+        var consumer = CreateCompilation(
+            "Consumer",
+            @"
+public class Callback : SharpGen.Runtime.CallbackBase, Binding.IDerived
+{
+}
+",
+            binding.ToMetadataReference()
+        );
+
+        var (code, diagnostics) = RunGenerator(consumer);
+
+        Assert.DoesNotContain("BaseVtbl", code);
+        Assert.DoesNotContain("DerivedVtbl", code);
+        Assert.DoesNotContain("IsRegistered<Binding.IDerived>", code);
+        Assert.Contains("TrimmingHelpers.PreserveMe<Callback>()", code);
+        Assert.Empty(diagnostics);
+    }
+
+    [Fact]
+    public void InternalForeignBaseVtblIsReadThroughStorage()
+    {
+        var binding = CreateCompilation("Binding", BindingSource);
+
+        var consumer = CreateCompilation(
+            "Consumer",
+            @"
+using System;
+using SharpGen.Runtime;
+
+public static class LocalVtbl
+{
+    public static readonly IntPtr[] Vtbl = new IntPtr[1];
+}
+
+[Vtbl(typeof(LocalVtbl)), System.Runtime.InteropServices.Guid(""33333333-3333-3333-3333-333333333333"")]
+public interface ILocal : Binding.IDerived
+{
+}
+",
+            binding.ToMetadataReference()
+        );
+
+        var (code, diagnostics) = RunGenerator(consumer);
+
+        Assert.Contains("helper.Add<Binding.IBase>();", code);
+        Assert.Contains("helper.Add<Binding.IDerived>();", code);
+        Assert.Contains("helper.Add(LocalVtbl.Vtbl);", code);
+        Assert.Empty(diagnostics);
+    }
+
+    [Fact]
+    public void FactoriesAreOnlyRegisteredForRequestedWrappers()
+    {
+        var consumer = CreateCompilation(
+            "Consumer",
+            @"
+using System;
+using SharpGen.Runtime;
+
+public class Queried : ComObject
+{
+    public Queried(IntPtr nativePtr) : base(nativePtr)
+    {
+    }
+}
+
+public class Created : CppObject
+{
+    public Created(IntPtr nativePtr) : base(nativePtr)
+    {
+    }
+}
+
+public class Unused : ComObject
+{
+    public Unused(IntPtr nativePtr) : base(nativePtr)
+    {
+    }
+}
+
+public static class Usage
+{
+    public static Queried Query(ComObject value) => value.QueryInterface<Queried>();
+
+    public static Created Create(IntPtr value) => MarshallingHelpers.FromPointer<Created>(value);
+
+    public static T QueryGeneric<T>(ComObject value) where T : ComObject => value.QueryInterface<T>();
+}
+"
+        );
+
+        var (code, diagnostics) = RunGenerator(consumer);
+
+        Assert.Contains(
+            "SharpGen.Runtime.TypeDataStorage.Storage<Queried>.Factory = static __nativePointer => new Queried(__nativePointer);",
+            code
+        );
+        Assert.Contains(
+            "SharpGen.Runtime.TypeDataStorage.Storage<Created>.Factory = static __nativePointer => new Created(__nativePointer);",
+            code
+        );
+        Assert.DoesNotContain("Storage<Unused>", code);
+        Assert.DoesNotContain("Storage<T>", code);
+        Assert.Empty(diagnostics);
+    }
+
+    private static CSharpCompilation CreateCompilation(string name, string source,
+                                                       params MetadataReference[] references) =>
+        CSharpCompilation.Create(
+            name,
+            new[] { CSharpSyntaxTree.ParseText(source) },
+            ((string) AppContext.GetData("TRUSTED_PLATFORM_ASSEMBLIES"))
+           .Split(Path.PathSeparator)
+           .Append(typeof(SharpGen.Runtime.CppObject).Assembly.Location)
+           .Distinct()
+           .Select(x => MetadataReference.CreateFromFile(x))
+           .Concat(references),
+            new CSharpCompilationOptions(OutputKind.DynamicallyLinkedLibrary, allowUnsafe: true)
+        );
+
+    private static (string Code, Diagnostic[] Errors) RunGenerator(Compilation compilation)
+    {
+        CSharpGeneratorDriver.Create(new SharpGenModuleGenerator())
+                             .RunGeneratorsAndUpdateCompilation(compilation, out var output, out _);
+
+        var code = string.Concat(output.SyntaxTrees.Skip(compilation.SyntaxTrees.Count()).Select(x => x.ToString()));
+        var errors = output.GetDiagnostics().Where(x => x.Severity == DiagnosticSeverity.Error).ToArray();
+
+        return (code, errors);
+    }
+}
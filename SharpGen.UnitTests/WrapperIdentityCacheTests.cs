@@ -0,0 +1,103 @@
+using SharpGen.Config;
+using SharpGen.CppModel;
+using SharpGen.UnitTests.Mapping;
+using Xunit;
+using Xunit.Abstractions;
+
+namespace SharpGen.UnitTests;
+
+public class WrapperIdentityCacheTests : MappingTestBase
+{
+    public WrapperIdentityCacheTests(ITestOutputHelper outputHelper) : base(outputHelper)
+    {
+    }
+
+    [Fact]
+    public void ReturnedInterfacesAreCreatedByDefault()
+    {
+        var code = Generate();
+
+        Assert.DoesNotContain("FromPointerCached", code);
+        Assert.Contains("new WrapperIdentityCacheTests.Interface(__result__native)", code);
+        AssertCompiles(code);
+    }
+
+    [Fact]
+    public void ReturnedInterfacesAreLookedUpInTheCache()
+    {
+        Ioc.GeneratorConfig.WrapperIdentityCache = true;
+
+        var code = Generate();
+
+        Assert.Contains(
+            "SharpGen.Runtime.MarshallingHelpers.FromPointerCached<WrapperIdentityCacheTests.Interface>(__result__native, static __nativePointer => new WrapperIdentityCacheTests.Interface(__nativePointer))",
+            code
+        );
+        Assert.Contains(
+            "SharpGen.Runtime.MarshallingHelpers.FromPointerCached<WrapperIdentityCacheTests.Interface>(value_, static __nativePointer => new WrapperIdentityCacheTests.Interface(__nativePointer))",
+            code
+        );
+
+        // The input parameters aren't owned by the wrappers
+        Assert.Contains("value_ = value?.NativePointer ?? System.IntPtr.Zero;", code);
+        AssertCompiles(code);
+    }
+
+    private string Generate()
+    {
+        var config = new ConfigFile
+        {
+            Id = nameof(WrapperIdentityCacheTests),
+            Namespace = nameof(WrapperIdentityCacheTests),
+            Includes =
+            {
+                new IncludeRule
+                {
+                    File = "interface.h",
+                    Attach = true,
+                    Namespace = nameof(WrapperIdentityCacheTests)
+                }
+            },
+            Bindings =
+            {
+                new BindRule("void", "System.Void")
+            }
+        };
+
+        var iface = new CppInterface("Interface");
+        iface.Add(
+            new CppMethod("GetParent")
+            {
+                ReturnValue = new CppReturnValue { TypeName = "Interface", Pointer = "*" },
+                Offset = 0,
+                WindowsOffset = 0
+            }
+        );
+
+        var queryChild = new CppMethod("QueryChild")
+        {
+            ReturnValue = new CppReturnValue { TypeName = "void" },
+            Offset = 1,
+            WindowsOffset = 1
+        };
+        queryChild.Add(new CppParameter("value") { TypeName = "Interface", Pointer = "**", Attribute = ParamAttribute.Out });
+        iface.Add(queryChild);
+
+        var setParent = new CppMethod("SetParent")
+        {
+            ReturnValue = new CppReturnValue { TypeName = "void" },
+            Offset = 2,
+            WindowsOffset = 2
+        };
+        setParent.Add(new CppParameter("value") { TypeName = "Interface", Pointer = "*", Attribute = ParamAttribute.In });
+        iface.Add(setParent);
+
+        var include = new CppInclude("interface");
+        include.Add(iface);
+
+        var module = new CppModule("SharpGenTestModule");
+        module.Add(include);
+
+        return GenerateCode(module, config);
+    }
+}
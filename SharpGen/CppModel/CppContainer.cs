@@ -7,19 +7,29 @@ namespace SharpGen.CppModel;
 public abstract class CppContainer : CppElement
 {
     private List<CppElement> items;
+    private int subtreeVersion;
 
     public IReadOnlyList<CppElement> Items
     {
         get => (IReadOnlyList<CppElement>) items ?? ImmutableList<CppElement>.Empty;
-        set => AdoptAllChildren(
-            items = value switch
-            {
-                List<CppElement> list => list,
-                _ => new List<CppElement>(value)
-            }
-        );
+        set
+        {
+            AdoptAllChildren(
+                items = value switch
+                {
+                    List<CppElement> list => list,
+                    _ => new List<CppElement>(value)
+                }
+            );
+            OnSubtreeChanged();
+        }
     }
 
+    /// <summary>
+    /// Gets a number incremented when elements are added to this container or to its descendants.
+    /// </summary>
+    internal int SubtreeVersion => subtreeVersion;
+
     protected internal virtual IEnumerable<CppElement> AllItems => Iterate<CppElement>();
 
     public bool IsEmpty => items == null || items.Count == 0;
@@ -34,6 +44,7 @@ public abstract class CppContainer : CppElement
         items ??= new List<CppElement>();
 
         items.Add(element);
+        OnSubtreeChanged();
     }
 
     public void AddRange(IEnumerable<CppElement> elements)
@@ -46,6 +57,8 @@ public abstract class CppContainer : CppElement
         var newCount = items.Count;
         for (var i = index; i < newCount; i++)
             AdoptChild(items[i]);
+
+        OnSubtreeChanged();
     }
 
     private void AdoptChild(CppElement element)
@@ -60,8 +73,15 @@ public abstract class CppContainer : CppElement
             AdoptChild(element);
     }
 
+    // Removed elements don't need to change the version, CppElementIndex checks that matched elements are still attached.
     internal void RemoveChild(CppElement child) => items?.Remove(child);
 
+    private void OnSubtreeChanged()
+    {
+        for (var container = this; container != null; container = container.Parent)
+            container.subtreeVersion++;
+    }
+
     /// <summary>
     ///   Iterates on items on this instance.
     /// </summary>
@@ -28,6 +28,7 @@ namespace SharpGen.CppModel;
 public abstract class CppElement
 {
     private MappingRule rule;
+    private string fullName;
 
     protected CppElement(string name)
     {
@@ -37,7 +38,17 @@ public abstract class CppElement
     public string Name { get; }
 
 #nullable enable
-    public CppContainer? Parent { get; internal set; }
+    private CppContainer? parent;
+
+    public CppContainer? Parent
+    {
+        get => parent;
+        internal set
+        {
+            parent = value;
+            InvalidateFullName();
+        }
+    }
 
     public MappingRule Rule => rule ??= new MappingRule();
 
@@ -66,12 +77,34 @@ public abstract class CppElement
 
     private protected virtual string Path => Parent != null ? Parent.FullName : string.Empty;
 
+    /// <summary>
+    /// Gets the full name of the element, computed once for each parent.
+    /// </summary>
     public virtual string FullName
     {
         get
         {
+            if (fullName != null)
+                return fullName;
+
             var path = Path;
-            return string.IsNullOrEmpty(path) ? Name : path + "::" + Name;
+            var name = string.IsNullOrEmpty(path) ? Name : path + "::" + Name;
+            return fullName = name;
+        }
+    }
+
+    private void InvalidateFullName()
+    {
+        // The full names of the children are only computed after the full name of their parent
+        if (fullName == null)
+            return;
+
+        fullName = null;
+
+        if (this is CppContainer container)
+        {
+            foreach (var item in container.Items)
+                item.InvalidateFullName();
         }
     }
 
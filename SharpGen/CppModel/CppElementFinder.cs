@@ -1,6 +1,5 @@
 ﻿using System;
 using System.Collections.Generic;
-using System.Linq;
 using System.Text.RegularExpressions;
 
 namespace SharpGen.CppModel;
@@ -41,42 +40,24 @@ public sealed class CppElementFinder
     public IEnumerable<T> Find<T>(Regex regex, SelectionMode mode = SelectionMode.MatchedElement)
         where T : CppElement
     {
-        return Find<T>(Root, regex, mode);
-    }
-
-    private IEnumerable<T> Find<T>(CppElement currentNode, Regex regex, SelectionMode mode) where T : CppElement
-    {
-        var path = currentNode.FullName;
-
-        var selectedElement = mode switch
+        var selectParent = mode switch
         {
-            SelectionMode.MatchedElement => currentNode,
-            SelectionMode.Parent => currentNode.Parent,
+            SelectionMode.MatchedElement => false,
+            SelectionMode.Parent => true,
             _ => throw new ArgumentException("Invalid selection mode.", nameof(mode))
         };
 
-        if (path != null && selectedElement is T cppElement && regex.IsMatch(path))
-        {
-            yield return cppElement;
-        }
-
-        if (currentNode is not CppContainer container)
-            yield break;
-
-        var elements = container.AllItems;
+        var index = CppElementIndex.Get(Root);
 
-        // Optimized version with context attributes
-        if (currentNode == Root && CurrentContexts.Count != 0)
+        foreach (var match in index.Match(regex, typeof(T), selectParent, CurrentContexts))
         {
-            elements = elements.Where(element => CurrentContexts.Contains(element.Name));
-        }
+            // Elements matched by a previous rule may have been removed since the index was built
+            if (!index.IsAttached(match))
+                continue;
 
-        foreach (var innerElement in elements)
-        {
-            foreach (var item in Find<T>(innerElement, regex, mode))
-            {
-                yield return item;
-            }
+            var selectedElement = selectParent ? index[match].Parent : index[match];
+            if (selectedElement is T cppElement)
+                yield return cppElement;
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,332 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.Runtime.CompilerServices;
+using System.Text;
+using System.Text.RegularExpressions;
+
+namespace SharpGen.CppModel;
+
+/// <summary>
+/// Flattened view of a C++ element tree, indexed by element kind and by full name.
+/// </summary>
+/// <remarks>
+/// The index is shared by all the <see cref="CppElementFinder"/> instances over the same root,
+/// and rebuilt when elements are added to the tree. Removed elements are filtered out when matched.
+/// </remarks>
+internal sealed class CppElementIndex
+{
+    private static readonly ConditionalWeakTable<CppElement, CppElementIndex> Indices = new();
+
+    // Guards the replacement of an outdated index in Indices
+    private static readonly object IndicesLock = new();
+
+    private readonly CppElement root;
+    private readonly int version;
+
+    // Elements in the order of a depth-first traversal, with their full name
+    // and the index of the root item containing them (-1 for the root itself).
+    private readonly List<CppElement> elements = new();
+    private readonly List<string?> fullNames = new();
+    private readonly List<int> rootItems = new();
+    private readonly List<string?> rootItemNames = new();
+
+    private readonly Dictionary<string, List<int>> elementsByFullName = new(StringComparer.Ordinal);
+    private readonly int[] elementsSortedByFullName;
+    private readonly Dictionary<(Type Kind, bool Parent), int[]> elementsByKind = new();
+
+    private CppElementIndex(CppElement root)
+    {
+        this.root = root;
+        version = GetVersion(root);
+
+        Add(root, -1);
+
+        if (root is CppContainer container)
+        {
+            foreach (var item in container.AllItems)
+            {
+                if (item == null)
+                    continue;
+
+                rootItemNames.Add(item.Name);
+                AddTree(item, rootItemNames.Count - 1);
+            }
+        }
+
+        List<int> named = new(elements.Count);
+        for (var i = 0; i < elements.Count; i++)
+        {
+            if (fullNames[i] is not { } fullName)
+                continue;
+
+            named.Add(i);
+
+            if (!elementsByFullName.TryGetValue(fullName, out var sameName))
+                elementsByFullName.Add(fullName, sameName = new List<int>(1));
+            sameName.Add(i);
+        }
+
+        elementsSortedByFullName = named.ToArray();
+        Array.Sort(
+            elementsSortedByFullName,
+            (x, y) => string.CompareOrdinal(fullNames[x], fullNames[y]) is var result and not 0 ? result : x - y
+        );
+    }
+
+    public static CppElementIndex Get(CppElement root)
+    {
+        lock (IndicesLock)
+        {
+            if (Indices.TryGetValue(root, out var index))
+            {
+                if (index.version == GetVersion(root))
+                    return index;
+
+                Indices.Remove(root);
+            }
+
+            index = new CppElementIndex(root);
+            Indices.Add(root, index);
+            return index;
+        }
+    }
+
+    private static int GetVersion(CppElement root) => root is CppContainer container ? container.SubtreeVersion : 0;
+
+    private void Add(CppElement element, int rootItem)
+    {
+        elements.Add(element);
+        fullNames.Add(element.FullName);
+        rootItems.Add(rootItem);
+    }
+
+    private void AddTree(CppElement element, int rootItem)
+    {
+        Add(element, rootItem);
+
+        if (element is not CppContainer container)
+            return;
+
+        foreach (var item in container.AllItems)
+        {
+            if (item != null)
+                AddTree(item, rootItem);
+        }
+    }
+
+    public CppElement this[int index] => elements[index];
+
+    /// <summary>
+    /// Checks whether the element is still part of the indexed tree.
+    /// </summary>
+    public bool IsAttached(int index)
+    {
+        for (var element = elements[index]; element != null; element = element.Parent)
+        {
+            if (ReferenceEquals(element, root))
+                return true;
+        }
+
+        return false;
+    }
+
+    /// <summary>
+    /// Finds the elements whose full name matches the regex.
+    /// </summary>
+    /// <param name="regex">The regex to match the full names against.</param>
+    /// <param name="kind">The type of the selected elements.</param>
+    /// <param name="selectParent">Whether the parent of the matched element is selected.</param>
+    /// <param name="contexts">The names of the root items to look into, all the tree when empty.</param>
+    /// <returns>The indices of the matched elements, in the order of a depth-first traversal.</returns>
+    public List<int> Match(Regex regex, Type kind, bool selectParent, ISet<string> contexts)
+    {
+        bool[]? rootItemInContext = null;
+        if (contexts.Count != 0)
+        {
+            rootItemInContext = new bool[rootItemNames.Count];
+            for (var i = 0; i < rootItemNames.Count; i++)
+                rootItemInContext[i] = contexts.Contains(rootItemNames[i]!);
+        }
+
+        IReadOnlyList<int> candidates;
+        var needsRegex = true;
+
+        var byKind = GetElementsByKind(kind, selectParent);
+
+        if (TryGetLiteralPrefix(regex, out var prefix, out var isExact) && isExact)
+        {
+            candidates = elementsByFullName.TryGetValue(prefix, out var sameName) ? sameName : Array.Empty<int>();
+            needsRegex = false;
+        }
+        else if (prefix.Length != 0 && GetPrefixRange(prefix, out var start) is var count && count < byKind.Length)
+        {
+            var range = new int[count];
+            Array.Copy(elementsSortedByFullName, start, range, 0, count);
+            Array.Sort(range);
+            candidates = range;
+        }
+        else
+        {
+            candidates = byKind;
+        }
+
+        List<int> matches = new();
+        foreach (var candidate in candidates)
+        {
+            var selected = selectParent ? elements[candidate].Parent : elements[candidate];
+            if (!kind.IsInstanceOfType(selected))
+                continue;
+
+            if (rootItemInContext != null && rootItems[candidate] is var rootItem and >= 0 && !rootItemInContext[rootItem])
+                continue;
+
+            if (fullNames[candidate] is not { } fullName || needsRegex && !regex.IsMatch(fullName))
+                continue;
+
+            matches.Add(candidate);
+        }
+
+        return matches;
+    }
+
+    private int[] GetElementsByKind(Type kind, bool selectParent)
+    {
+        // The index is shared by the finders of every thread
+        lock (elementsByKind)
+        {
+            if (elementsByKind.TryGetValue((kind, selectParent), out var byKind))
+                return byKind;
+
+            List<int> matching = new();
+            for (var i = 0; i < elements.Count; i++)
+            {
+                var selected = selectParent ? elements[i].Parent : elements[i];
+                if (fullNames[i] != null && kind.IsInstanceOfType(selected))
+                    matching.Add(i);
+            }
+
+            byKind = matching.ToArray();
+            elementsByKind.Add((kind, selectParent), byKind);
+            return byKind;
+        }
+    }
+
+    /// <summary>
+    /// Finds the range of <see cref="elementsSortedByFullName"/> starting with the prefix.
+    /// </summary>
+    private int GetPrefixRange(string prefix, out int start)
+    {
+        start = LowerBound(prefix, 0);
+        return LowerBound(prefix, 1) - start;
+    }
+
+    private int LowerBound(string prefix, int threshold)
+    {
+        int low = 0, high = elementsSortedByFullName.Length;
+        while (low < high)
+        {
+            var middle = low + (high - low) / 2;
+            var fullName = fullNames[elementsSortedByFullName[middle]]!;
+
+            var comparison = string.CompareOrdinal(fullName, 0, prefix, 0, prefix.Length);
+            if (comparison == 0 && fullName.Length < prefix.Length)
+                comparison = -1;
+
+            if (comparison < threshold)
+                low = middle + 1;
+            else
+                high = middle;
+        }
+
+        return low;
+    }
+
+    /// <summary>
+    /// Extracts the literal text every match of an anchored regex starts with.
+    /// </summary>
+    /// <param name="regex">The regex.</param>
+    /// <param name="prefix">The literal prefix, empty when the regex doesn't start with literal text.</param>
+    /// <param name="isExact">Whether the regex matches the prefix only.</param>
+    /// <returns><c>true</c> if the regex is anchored at the start and its options allow to extract a prefix.</returns>
+    internal static bool TryGetLiteralPrefix(Regex regex, out string prefix, out bool isExact)
+    {
+        prefix = string.Empty;
+        isExact = false;
+
+        if ((regex.Options & ~(RegexOptions.Compiled | RegexOptions.CultureInvariant)) != 0)
+            return false;
+
+        var pattern = regex.ToString();
+        if (pattern.Length == 0 || pattern[0] != '^' || HasTopLevelAlternation(pattern))
+            return false;
+
+        StringBuilder literal = new(pattern.Length);
+        for (var i = 1; i < pattern.Length; i++)
+        {
+            var c = pattern[i];
+            switch (c)
+            {
+                case '\\' when i + 1 < pattern.Length && !char.IsLetterOrDigit(pattern[i + 1]):
+                    literal.Append(pattern[++i]);
+                    continue;
+                case '$' when i == pattern.Length - 1:
+                    isExact = true;
+                    break;
+                case '*' or '?' or '{' when literal.Length != 0:
+                    // The previous character is optional
+                    literal.Length--;
+                    break;
+                case '\\' or '.' or '$' or '^' or '[' or '(' or ')' or '|' or '*' or '+' or '?' or '{':
+                    break;
+                default:
+                    literal.Append(c);
+                    continue;
+            }
+
+            break;
+        }
+
+        prefix = literal.ToString();
+        return true;
+    }
+
+    private static bool HasTopLevelAlternation(string pattern)
+    {
+        var depth = 0;
+        for (var i = 0; i < pattern.Length; i++)
+        {
+            switch (pattern[i])
+            {
+                case '\\':
+                    i++;
+                    break;
+                case '[':
+                    // Skip the character class, a leading ']' is part of the class
+                    i++;
+                    if (i < pattern.Length && pattern[i] == '^')
+                        i++;
+                    if (i < pattern.Length && pattern[i] == ']')
+                        i++;
+                    while (i < pattern.Length && pattern[i] != ']')
+                    {
+                        if (pattern[i] == '\\')
+                            i++;
+                        i++;
+                    }
+                    break;
+                case '(':
+                    depth++;
+                    break;
+                case ')':
+                    depth--;
+                    break;
+                case '|' when depth == 0:
+                    return true;
+            }
+        }
+
+        return false;
+    }
+}
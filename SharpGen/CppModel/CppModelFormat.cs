@@ -0,0 +1,29 @@
+namespace SharpGen.CppModel;
+
+/// <summary>
+/// Constants shared by <see cref="CppModelWriter"/> and <see cref="CppModelReader"/>.
+/// </summary>
+internal static class CppModelFormat
+{
+    public const int NullString = 0;
+    public const int NewString = 1;
+    public const int FirstStringReference = 2;
+
+    public enum ElementKind : byte
+    {
+        Include = 1,
+        Interface,
+        Struct,
+        Enum,
+        Method,
+        Function,
+        Parameter,
+        ReturnValue,
+        Field,
+        EnumItem,
+        Constant,
+        Define,
+        Guid,
+        Module
+    }
+}
@@ -0,0 +1,212 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Runtime.InteropServices;
+using System.Text;
+using SharpGen.Config;
+
+namespace SharpGen.CppModel;
+
+/// <summary>
+/// Reads C++ model elements written by <see cref="CppModelWriter"/>.
+/// </summary>
+public sealed class CppModelReader : IDisposable
+{
+    private readonly BinaryReader reader;
+    private readonly List<string> strings = new();
+
+    public CppModelReader(Stream stream, bool leaveOpen = false)
+    {
+        reader = new BinaryReader(stream, Encoding.UTF8, leaveOpen);
+    }
+
+    public string? ReadString()
+    {
+        var marker = Read7BitEncodedInt();
+        switch (marker)
+        {
+            case CppModelFormat.NullString:
+                return null;
+            case CppModelFormat.NewString:
+                var value = reader.ReadString();
+                strings.Add(value);
+                return value;
+            default:
+                var index = marker - CppModelFormat.FirstStringReference;
+                if ((uint) index >= (uint) strings.Count)
+                    throw new InvalidDataException($"String reference {index} is out of range.");
+                return strings[index];
+        }
+    }
+
+    public int ReadInt() => Read7BitEncodedInt();
+
+    /// <summary>
+    /// Reads an element with all its children.
+    /// </summary>
+    public CppElement ReadElement()
+    {
+        var kind = (CppModelFormat.ElementKind) reader.ReadByte();
+        var name = ReadString();
+
+        switch (kind)
+        {
+            case CppModelFormat.ElementKind.Module:
+            {
+                CppModule module = new(name);
+                ReadChildren(module);
+                return module;
+            }
+            case CppModelFormat.ElementKind.Include:
+            {
+                CppInclude include = new(name);
+                ReadChildren(include);
+                return include;
+            }
+            case CppModelFormat.ElementKind.Interface:
+            {
+                CppInterface cppInterface = new(name)
+                {
+                    Guid = ReadString(),
+                    Base = ReadString(),
+                    TotalMethodCount = Read7BitEncodedInt()
+                };
+                ReadChildren(cppInterface);
+                return cppInterface;
+            }
+            case CppModelFormat.ElementKind.Struct:
+            {
+                CppStruct cppStruct = new(name)
+                {
+                    Base = ReadString(),
+                    IsUnion = reader.ReadBoolean()
+                };
+                ReadChildren(cppStruct);
+                return cppStruct;
+            }
+            case CppModelFormat.ElementKind.Enum:
+            {
+                CppEnum cppEnum = new(name)
+                {
+                    UnderlyingType = ReadString()
+                };
+                ReadChildren(cppEnum);
+                return cppEnum;
+            }
+            case CppModelFormat.ElementKind.Method:
+            {
+                CppMethod method = new(name)
+                {
+                    Offset = Read7BitEncodedInt(),
+                    WindowsOffset = Read7BitEncodedInt()
+                };
+                ReadCallable(method);
+                return method;
+            }
+            case CppModelFormat.ElementKind.Function:
+            {
+                CppFunction function = new(name);
+                ReadCallable(function);
+                return function;
+            }
+            case CppModelFormat.ElementKind.Parameter:
+            {
+                CppParameter parameter = new(name)
+                {
+                    Attribute = (ParamAttribute) Read7BitEncodedInt()
+                };
+                ReadMarshallable(parameter);
+                return parameter;
+            }
+            case CppModelFormat.ElementKind.ReturnValue:
+            {
+                CppReturnValue returnValue = new();
+                ReadMarshallable(returnValue);
+                return returnValue;
+            }
+            case CppModelFormat.ElementKind.Field:
+            {
+                CppField field = new(name)
+                {
+                    Offset = Read7BitEncodedInt(),
+                    IsBitField = reader.ReadBoolean(),
+                    BitOffset = Read7BitEncodedInt()
+                };
+                ReadMarshallable(field);
+                return field;
+            }
+            case CppModelFormat.ElementKind.EnumItem:
+                return new CppEnumItem(name, ReadString());
+            case CppModelFormat.ElementKind.Constant:
+            {
+                var typeName = ReadString();
+                return new CppConstant(name, typeName, ReadString());
+            }
+            case CppModelFormat.ElementKind.Define:
+                return new CppDefine(name, ReadString());
+            case CppModelFormat.ElementKind.Guid:
+                return new CppGuid(name, new Guid(reader.ReadBytes(16)));
+            default:
+                throw new InvalidDataException($"Unknown C++ element kind {(byte) kind}.");
+        }
+    }
+
+    /// <summary>
+    /// Reads a list of elements written by <see cref="CppModelWriter.WriteElements"/>.
+    /// </summary>
+    public List<CppElement> ReadElements()
+    {
+        var count = Read7BitEncodedInt();
+        List<CppElement> elements = new(count);
+        for (var i = 0; i < count; i++)
+            elements.Add(ReadElement());
+        return elements;
+    }
+
+    private void ReadChildren(CppContainer container)
+    {
+        var children = ReadElements();
+        if (children.Count != 0)
+            container.AddRange(children);
+    }
+
+    private void ReadCallable(CppCallable callable)
+    {
+        callable.CallingConvention = (CallingConvention) Read7BitEncodedInt();
+        if (reader.ReadBoolean())
+            callable.ReturnValue = (CppReturnValue) ReadElement();
+        ReadChildren(callable);
+    }
+
+    private void ReadMarshallable(CppMarshallable marshallable)
+    {
+        marshallable.TypeName = ReadString()!;
+        // The pointer is stored in the mapping rule, only create it when needed
+        if (ReadString() is { Length: > 0 } pointer)
+            marshallable.Pointer = pointer;
+        marshallable.Const = reader.ReadBoolean();
+        marshallable.ArrayDimension = ReadString();
+    }
+
+    private int Read7BitEncodedInt()
+    {
+        uint result = 0;
+        var shift = 0;
+        byte current;
+        do
+        {
+            if (shift == 35)
+                throw new InvalidDataException("Malformed 7-bit encoded integer.");
+
+            current = reader.ReadByte();
+            result |= (uint) (current & 0x7F) << shift;
+            shift += 7;
+        } while ((current & 0x80) != 0);
+
+        return (int) result;
+    }
+
+    public void Dispose() => reader.Dispose();
+}
@@ -0,0 +1,179 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Text;
+
+namespace SharpGen.CppModel;
+
+/// <summary>
+/// Writes parsed C++ model elements in a compact binary form, readable by <see cref="CppModelReader"/>.
+/// </summary>
+/// <remarks>
+/// Only the state produced by the C++ parser is written, mapping rules applied later are not part of the output.
+/// Strings are written once and referenced by index afterwards.
+/// </remarks>
+public sealed class CppModelWriter : IDisposable
+{
+    private readonly BinaryWriter writer;
+    private readonly Dictionary<string, int> strings = new(StringComparer.Ordinal);
+
+    public CppModelWriter(Stream stream, bool leaveOpen = false)
+    {
+        writer = new BinaryWriter(stream, Encoding.UTF8, leaveOpen);
+    }
+
+    public void WriteString(string? value)
+    {
+        if (value is null)
+        {
+            Write7BitEncodedInt(CppModelFormat.NullString);
+            return;
+        }
+
+        if (strings.TryGetValue(value, out var index))
+        {
+            Write7BitEncodedInt(CppModelFormat.FirstStringReference + index);
+            return;
+        }
+
+        strings.Add(value, strings.Count);
+        Write7BitEncodedInt(CppModelFormat.NewString);
+        writer.Write(value);
+    }
+
+    public void WriteInt(int value) => Write7BitEncodedInt(value);
+
+    /// <summary>
+    /// Writes the element with all its children.
+    /// </summary>
+    public void WriteElement(CppElement element)
+    {
+        switch (element)
+        {
+            case CppModule module:
+                WriteHeader(CppModelFormat.ElementKind.Module, module);
+                WriteChildren(module);
+                break;
+            case CppInclude include:
+                WriteHeader(CppModelFormat.ElementKind.Include, include);
+                WriteChildren(include);
+                break;
+            case CppInterface cppInterface:
+                WriteHeader(CppModelFormat.ElementKind.Interface, cppInterface);
+                WriteString(cppInterface.Guid);
+                WriteString(cppInterface.Base);
+                Write7BitEncodedInt(cppInterface.TotalMethodCount);
+                WriteChildren(cppInterface);
+                break;
+            case CppStruct cppStruct:
+                WriteHeader(CppModelFormat.ElementKind.Struct, cppStruct);
+                WriteString(cppStruct.Base);
+                writer.Write(cppStruct.IsUnion);
+                WriteChildren(cppStruct);
+                break;
+            case CppEnum cppEnum:
+                WriteHeader(CppModelFormat.ElementKind.Enum, cppEnum);
+                WriteString(cppEnum.UnderlyingType);
+                WriteChildren(cppEnum);
+                break;
+            case CppMethod method:
+                WriteHeader(CppModelFormat.ElementKind.Method, method);
+                Write7BitEncodedInt(method.Offset);
+                Write7BitEncodedInt(method.WindowsOffset);
+                WriteCallable(method);
+                break;
+            case CppFunction function:
+                WriteHeader(CppModelFormat.ElementKind.Function, function);
+                WriteCallable(function);
+                break;
+            case CppParameter parameter:
+                WriteHeader(CppModelFormat.ElementKind.Parameter, parameter);
+                Write7BitEncodedInt((int) parameter.Attribute);
+                WriteMarshallable(parameter);
+                break;
+            case CppReturnValue returnValue:
+                WriteHeader(CppModelFormat.ElementKind.ReturnValue, returnValue);
+                WriteMarshallable(returnValue);
+                break;
+            case CppField field:
+                WriteHeader(CppModelFormat.ElementKind.Field, field);
+                Write7BitEncodedInt(field.Offset);
+                writer.Write(field.IsBitField);
+                Write7BitEncodedInt(field.BitOffset);
+                WriteMarshallable(field);
+                break;
+            case CppEnumItem enumItem:
+                WriteHeader(CppModelFormat.ElementKind.EnumItem, enumItem);
+                WriteString(enumItem.Value);
+                break;
+            case CppConstant constant:
+                WriteHeader(CppModelFormat.ElementKind.Constant, constant);
+                WriteString(constant.TypeName);
+                WriteString(constant.Value);
+                break;
+            case CppDefine define:
+                WriteHeader(CppModelFormat.ElementKind.Define, define);
+                WriteString(define.Value);
+                break;
+            case CppGuid guid:
+                WriteHeader(CppModelFormat.ElementKind.Guid, guid);
+                writer.Write(guid.Guid.ToByteArray());
+                break;
+            default:
+                throw new ArgumentOutOfRangeException(
+                    nameof(element), element.GetType().Name, "Unsupported C++ element type"
+                );
+        }
+    }
+
+    /// <summary>
+    /// Writes the specified elements, preceded by their count.
+    /// </summary>
+    public void WriteElements(IReadOnlyCollection<CppElement> elements)
+    {
+        Write7BitEncodedInt(elements.Count);
+        foreach (var element in elements)
+            WriteElement(element);
+    }
+
+    private void WriteHeader(CppModelFormat.ElementKind kind, CppElement element)
+    {
+        writer.Write((byte) kind);
+        WriteString(element.Name);
+    }
+
+    private void WriteChildren(CppContainer container) => WriteElements(container.Items);
+
+    private void WriteCallable(CppCallable callable)
+    {
+        Write7BitEncodedInt((int) callable.CallingConvention);
+        writer.Write(callable.ReturnValue != null);
+        if (callable.ReturnValue != null)
+            WriteElement(callable.ReturnValue);
+        WriteChildren(callable);
+    }
+
+    private void WriteMarshallable(CppMarshallable marshallable)
+    {
+        WriteString(marshallable.TypeName);
+        WriteString(marshallable.Pointer);
+        writer.Write(marshallable.Const);
+        WriteString(marshallable.ArrayDimension);
+    }
+
+    private void Write7BitEncodedInt(int value)
+    {
+        var v = (uint) value;
+        while (v >= 0x80)
+        {
+            writer.Write((byte) (v | 0x80));
+            v >>= 7;
+        }
+
+        writer.Write((byte) v);
+    }
+
+    public void Dispose() => writer.Dispose();
+}
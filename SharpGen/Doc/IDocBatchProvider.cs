@@ -0,0 +1,33 @@
+#nullable enable
+
+using System.Collections.Generic;
+using System.Threading.Tasks;
+
+namespace SharpGen.Doc;
+
+/// <summary>
+/// An <see cref="IDocProvider"/> able to find the documentation of many C++ items in a single query.
+/// </summary>
+/// <remarks>
+/// The names without a successful result, or the whole batch when the query throws, are queried again
+/// one by one through <see cref="IDocProvider.FindDocumentationAsync(string, IDocumentationContext)"/>,
+/// which keeps the retry behavior of the single queries.
+/// </remarks>
+public interface IDocBatchProvider : IDocProvider
+{
+    /// <summary>
+    /// The maximum number of names passed to a single batch query.
+    /// </summary>
+    int MaxBatchSize { get; }
+
+    /// <summary>
+    /// Finds the documentation for many C++ items.
+    /// </summary>
+    /// <param name="fullNames">
+    /// The full names, in the format of <see cref="IDocProvider.FindDocumentationAsync(string, IDocumentationContext)"/>.
+    /// </param>
+    /// <param name="context">Environment for documenting, used to create items and subitems</param>
+    /// <returns>One non-null result per name, in the order of <paramref name="fullNames"/></returns>
+    Task<IReadOnlyList<IFindDocumentationResult>> FindDocumentationAsync(IReadOnlyList<string> fullNames,
+                                                                         IDocumentationContext context);
+}
@@ -21,6 +21,7 @@ public sealed class DefaultGenerators : IGeneratorRegistry
         Method = new MethodCodeGenerator(ioc);
         Function = new FunctionCodeGenerator(ioc);
         FunctionImport = new FunctionImportCodeGenerator(ioc);
+        FunctionPointerImports = new FunctionPointerImportsCodeGenerator(ioc);
         Interface = new InterfaceCodeGenerator(ioc);
         Group = new GroupCodeGenerator(ioc);
         ShadowCallable = new ShadowCallbackGenerator(ioc);
@@ -45,6 +46,7 @@ public sealed class DefaultGenerators : IGeneratorRegistry
     public IMemberCodeGenerator<CsMethod> Method { get; }
     public IMemberCodeGenerator<CsFunction> Function { get; }
     public IMemberCodeGenerator<CsFunction> FunctionImport { get; }
+    public IMemberCodeGenerator<CsGroup> FunctionPointerImports { get; }
     public IMemberCodeGenerator<CsInterface> Interface { get; }
     public IMemberCodeGenerator<CsInterface> Vtbl { get; }
     public IMemberCodeGenerator<CsCallable> ShadowCallable { get; }
@@ -14,7 +14,10 @@ internal sealed class FunctionCodeGenerator : MemberMultiCodeGeneratorBase<CsFun
     {
         var list = NewMemberList;
         list.Add(csElement, Generators.Callable);
-        list.Add(csElement, Generators.FunctionImport);
+
+        // The function pointers are declared once per group instead
+        if (!Generators.Config.FunctionPointerImports)
+            list.Add(csElement, Generators.FunctionImport);
         return list;
     }
 }
\ No newline at end of file
@@ -0,0 +1,125 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.Linq;
+using Microsoft.CodeAnalysis;
+using Microsoft.CodeAnalysis.CSharp;
+using Microsoft.CodeAnalysis.CSharp.Syntax;
+using SharpGen.Model;
+using static Microsoft.CodeAnalysis.CSharp.SyntaxFactory;
+
+namespace SharpGen.Generator;
+
+/// <summary>
+/// Declares the function pointers of the native functions of a group, when
+/// <see cref="GeneratorConfig.FunctionPointerImports"/> is enabled.
+/// </summary>
+/// <remarks>
+/// The pointers are the static fields of a nested class, resolved by its type initializer.
+/// The libraries and exports of a group are then resolved once, when one of its functions is first called,
+/// and a call is a plain unmanaged function pointer call.
+/// A missing library or export makes every function of the group throw a <c>TypeInitializationException</c>.
+/// </remarks>
+internal sealed class FunctionPointerImportsCodeGenerator : MemberSingleCodeGeneratorBase<CsGroup>
+{
+    internal const string ClassName = "__Imports";
+
+    private static readonly NameSyntax NativeLibraryName = ParseName("System.Runtime.InteropServices.NativeLibrary");
+
+    private static readonly SyntaxTokenList ClassModifierList = TokenList(
+        Token(SyntaxKind.PrivateKeyword), Token(SyntaxKind.StaticKeyword), Token(SyntaxKind.UnsafeKeyword)
+    );
+
+    private static readonly SyntaxTokenList LibraryModifierList = TokenList(
+        Token(SyntaxKind.PrivateKeyword), Token(SyntaxKind.StaticKeyword), Token(SyntaxKind.ReadOnlyKeyword)
+    );
+
+    private static readonly SyntaxTokenList FunctionModifierList = TokenList(
+        Token(SyntaxKind.InternalKeyword), Token(SyntaxKind.StaticKeyword), Token(SyntaxKind.ReadOnlyKeyword)
+    );
+
+    public FunctionPointerImportsCodeGenerator(Ioc ioc) : base(ioc)
+    {
+    }
+
+    /// <summary>
+    /// The expression of the function pointer of a native function.
+    /// </summary>
+    internal static ExpressionSyntax FunctionPointer(CsFunction function) => MemberAccessExpression(
+        SyntaxKind.SimpleMemberAccessExpression, IdentifierName(ClassName), IdentifierName(function.CppElementName)
+    );
+
+    public override MemberDeclarationSyntax? GenerateCode(CsGroup csElement)
+    {
+        var functions = csElement.Functions.ToArray();
+        if (functions.Length == 0)
+            return null;
+
+        // The fields are initialized in their declaration order, the libraries first
+        var libraries = functions.Select(x => x.DllName).Distinct().ToArray();
+        List<MemberDeclarationSyntax> members = new(libraries.Length + functions.Length);
+
+        members.AddRange(
+            libraries.Select(
+                (library, i) => Field(
+                    LibraryModifierList, GeneratorHelpers.IntPtrType, LibraryFieldName(i),
+                    NativeLibraryCall(
+                        "Load",
+                        Argument(IdentifierName(library)),
+                        Argument(
+                            MemberAccessExpression(
+                                SyntaxKind.SimpleMemberAccessExpression,
+                                TypeOfExpression(IdentifierName(ClassName)),
+                                IdentifierName("Assembly")
+                            )
+                        ),
+                        Argument(NullLiteral)
+                    )
+                )
+            )
+        );
+
+        members.AddRange(
+            functions.Select(
+                function => Field(
+                    FunctionModifierList, GeneratorHelpers.VoidPtrType, function.CppElementName,
+                    CastExpression(
+                        GeneratorHelpers.VoidPtrType,
+                        NativeLibraryCall(
+                            "GetExport",
+                            Argument(IdentifierName(LibraryFieldName(Array.IndexOf(libraries, function.DllName)))),
+                            Argument(
+                                LiteralExpression(SyntaxKind.StringLiteralExpression, Literal(function.CppElementName))
+                            )
+                        )
+                    )
+                )
+            )
+        );
+
+        return ClassDeclaration(ClassName)
+              .WithModifiers(ClassModifierList)
+              .WithMembers(List(members));
+    }
+
+    private static string LibraryFieldName(int index) => "Library" + index;
+
+    private static FieldDeclarationSyntax Field(SyntaxTokenList modifiers, TypeSyntax type, string name,
+                                                ExpressionSyntax value) =>
+        FieldDeclaration(
+                VariableDeclaration(
+                    type,
+                    SingletonSeparatedList(
+                        VariableDeclarator(Identifier(name)).WithInitializer(EqualsValueClause(value))
+                    )
+                )
+            )
+           .WithModifiers(modifiers);
+
+    private static InvocationExpressionSyntax NativeLibraryCall(string name, params ArgumentSyntax[] arguments) =>
+        InvocationExpression(
+            MemberAccessExpression(SyntaxKind.SimpleMemberAccessExpression, NativeLibraryName, IdentifierName(name)),
+            ArgumentList(SeparatedList(arguments))
+        );
+}
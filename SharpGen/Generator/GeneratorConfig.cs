@@ -5,4 +5,23 @@ namespace SharpGen.Generator;
 public sealed class GeneratorConfig
 {
     public PlatformDetectionType Platforms { get; set; } = PlatformDetectionType.Any;
+
+    /// <summary>
+    /// Calls the native functions through unmanaged function pointers resolved with <c>NativeLibrary</c>
+    /// when a function of their group is first called, instead of <c>DllImport</c> declarations.
+    /// </summary>
+    public bool FunctionPointerImports { get; set; }
+
+    /// <summary>
+    /// Implements the vtables of the shadows with <c>UnmanagedCallersOnly</c> methods on .NET 5 as well as .NET 6,
+    /// for every method having a blittable native signature. The generated code requires .NET 5 or later:
+    /// there is no delegate fallback for older target frameworks.
+    /// </summary>
+    public bool FunctionPointerShadows { get; set; }
+
+    /// <summary>
+    /// Returns the live wrapper of an interface pointer returned by a native call, when there is one,
+    /// instead of a new wrapper for every call.
+    /// </summary>
+    public bool WrapperIdentityCache { get; set; }
 }
\ No newline at end of file
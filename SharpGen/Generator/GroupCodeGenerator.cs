@@ -19,6 +19,9 @@ internal sealed class GroupCodeGenerator : MemberSingleCodeGeneratorBase<CsGroup
         list.AddRange(csElement.ResultConstants, Generators.ResultConstant);
         list.AddRange(csElement.Functions, Generators.Function);
 
+        if (Generators.Config.FunctionPointerImports)
+            list.Add(csElement, Generators.FunctionPointerImports);
+
         return AddDocumentationTrivia(
             ClassDeclaration(Identifier(csElement.Name))
                .WithModifiers(csElement.VisibilityTokenList.Add(Token(SyntaxKind.PartialKeyword)))
@@ -19,6 +19,7 @@ public interface IGeneratorRegistry
     IMemberCodeGenerator<CsMethod> Method { get; }
     IMemberCodeGenerator<CsFunction> Function { get; }
     IMemberCodeGenerator<CsFunction> FunctionImport { get; }
+    IMemberCodeGenerator<CsGroup> FunctionPointerImports { get; }
     IMemberCodeGenerator<CsInterface> Interface { get; }
     IMemberCodeGenerator<CsInterface> Vtbl { get; }
     IMemberCodeGenerator<CsCallable> ShadowCallable { get; }
@@ -230,9 +230,9 @@ internal abstract partial class MarshallerBase
             _ => throw new ArgumentException(nameof(marshallable))
         };
 
-    protected static StatementSyntax MarshalInterfaceInstanceFromNative(CsMarshalBase csElement,
-                                                                        ExpressionSyntax publicElement,
-                                                                        ExpressionSyntax marshalElement) =>
+    protected StatementSyntax MarshalInterfaceInstanceFromNative(CsMarshalBase csElement,
+                                                                 ExpressionSyntax publicElement,
+                                                                 ExpressionSyntax marshalElement) =>
         ExpressionStatement(
             csElement switch
             {
@@ -244,6 +244,12 @@ internal abstract partial class MarshallerBase
                     ),
                     marshalElement
                 ),
+                // The native calls return the out parameters and the return values with a reference
+                CsReturnValue or CsParameter {IsOut: true} when ioc.GeneratorConfig.WrapperIdentityCache =>
+                    AssignmentExpression(
+                        SyntaxKind.SimpleAssignmentExpression, publicElement,
+                        FromPointerCached(csElement, marshalElement)
+                    ),
                 _ => AssignmentExpression(
                     SyntaxKind.SimpleAssignmentExpression, publicElement,
                     ConditionalExpression(
@@ -258,6 +264,39 @@ internal abstract partial class MarshallerBase
             }
         );
 
+    private InvocationExpressionSyntax FromPointerCached(CsMarshalBase csElement, ExpressionSyntax marshalElement)
+    {
+        var implementation = ParseTypeName(csElement.PublicType.GetNativeImplementationQualifiedName());
+        var pointer = Identifier("__nativePointer");
+
+        return InvocationExpression(
+            MemberAccessExpression(
+                SyntaxKind.SimpleMemberAccessExpression,
+                GlobalNamespace.GetTypeNameSyntax(WellKnownName.MarshallingHelpers),
+                GenericName(Identifier("FromPointerCached"))
+                   .WithTypeArgumentList(TypeArgumentList(SingletonSeparatedList(implementation)))
+            ),
+            ArgumentList(
+                SeparatedList(
+                    new[]
+                    {
+                        Argument(marshalElement),
+                        Argument(
+                            SimpleLambdaExpression(Parameter(pointer))
+                               .WithModifiers(TokenList(Token(SyntaxKind.StaticKeyword)))
+                               .WithExpressionBody(
+                                    ObjectCreationExpression(implementation)
+                                       .WithArgumentList(
+                                            ArgumentList(SingletonSeparatedList(Argument(IdentifierName(pointer))))
+                                        )
+                                )
+                        )
+                    }
+                )
+            )
+        );
+    }
+
     protected ExpressionStatementSyntax MarshalInterfaceInstanceToNative(CsMarshalBase csElement,
                                                                          ExpressionSyntax publicElement,
                                                                          ExpressionSyntax marshalElement) =>
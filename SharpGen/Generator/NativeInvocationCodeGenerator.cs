@@ -59,7 +59,7 @@ internal sealed class NativeInvocationCodeGenerator : ExpressionPlatformSingleCo
             _ => null
         };
 
-        ExpressionSyntax FnPtrCall()
+        ExpressionSyntax FnPtrCall(ExpressionSyntax functionPointer)
         {
             var fnptrParameters = arguments
                                  .Select(x => x.Type)
@@ -80,16 +80,19 @@ internal sealed class NativeInvocationCodeGenerator : ExpressionPlatformSingleCo
                     ),
                     FunctionPointerParameterList(SeparatedList(fnptrParameters))
                 ),
-                vtblAccess
+                functionPointer
             );
         }
 
         var what = callable switch
         {
+            CsFunction function when Generators.Config.FunctionPointerImports => GeneratorHelpers.WrapInParentheses(
+                FnPtrCall(FunctionPointerImportsCodeGenerator.FunctionPointer(function))
+            ),
             CsFunction => IdentifierName(
                 callable.CppElementName + GeneratorHelpers.GetPlatformSpecificSuffix(platform)
             ),
-            CsMethod => GeneratorHelpers.WrapInParentheses(FnPtrCall()),
+            CsMethod => GeneratorHelpers.WrapInParentheses(FnPtrCall(vtblAccess)),
             _ => throw new ArgumentOutOfRangeException()
         };
 
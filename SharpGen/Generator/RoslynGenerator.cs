@@ -2,9 +2,12 @@
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Runtime.ExceptionServices;
+using System.Threading.Tasks;
 using Microsoft.CodeAnalysis;
 using Microsoft.CodeAnalysis.CSharp;
 using Microsoft.CodeAnalysis.CSharp.Syntax;
+using SharpGen.Logging;
 using SharpGen.Model;
 using static Microsoft.CodeAnalysis.CSharp.SyntaxFactory;
 
@@ -14,47 +17,117 @@ public sealed class RoslynGenerator
 {
     private static readonly SyntaxTokenList ModuleInitModifiers = TokenList(Token(SyntaxKind.InternalKeyword), Token(SyntaxKind.StaticKeyword));
     private const string AutoGeneratedCommentText = "// <auto-generated/>\n";
+    private const string ModuleDataInitializerName = "ModuleDataInitializer";
     private static readonly AttributeListSyntax ModuleInitializerAttributeList = AttributeList(
         SingletonSeparatedList(Attribute(ParseName("System.Runtime.CompilerServices.ModuleInitializerAttribute")))
     );
 
     public SyntaxTree Run(CsAssembly csAssembly, Ioc ioc)
     {
-        var logger = ioc.Logger;
+        ioc.Logger.Message("Generating Roslyn syntax tree...");
+
+        SyntaxList<MemberDeclarationSyntax> members;
+        using (PhaseTrace.Begin("Generate syntax"))
+        {
+            members = List(csAssembly.Namespaces.Select(ns => GenerateNamespace(ns, ioc)))
+               .AddRange(GenerateModuleInitializer(csAssembly, ioc));
+        }
+
+        return CreateSyntaxTree(members);
+    }
+
+    /// <summary>
+    /// Generates one syntax tree per namespace, concurrently.
+    /// </summary>
+    /// <param name="csAssembly">The C# model to generate code for.</param>
+    /// <param name="ioc">The services to generate code with.</param>
+    /// <param name="maxDegreeOfParallelism">
+    /// The maximum number of namespaces generated at the same time, <c>0</c> to use as many workers as there are processors.
+    /// </param>
+    /// <returns>
+    /// The syntax trees of the namespaces with their name, in the order of <see cref="CsAssembly.Namespaces"/>,
+    /// followed by the module initializer tree with a <c>null</c> name if the assembly has result codes to register.
+    /// Each tree is normalized on its own.
+    /// </returns>
+    public IReadOnlyList<(string Namespace, SyntaxTree Tree)> RunPerNamespace(CsAssembly csAssembly, Ioc ioc,
+                                                                         int maxDegreeOfParallelism)
+    {
+        ioc.Logger.Message("Generating Roslyn syntax trees...");
+
+        var namespaces = csAssembly.Namespaces.ToArray();
+        var trees = new (string Namespace, SyntaxTree Tree)[namespaces.Length];
+
+        try
+        {
+            Parallel.For(
+                0, namespaces.Length,
+                new ParallelOptions
+                {
+                    MaxDegreeOfParallelism = maxDegreeOfParallelism > 0
+                                                 ? maxDegreeOfParallelism
+                                                 : Environment.ProcessorCount
+                },
+                i =>
+                {
+                    var ns = namespaces[i];
+
+                    MemberDeclarationSyntax member;
+                    using (PhaseTrace.Begin($"Generate syntax [{ns.Name}]"))
+                        member = GenerateNamespace(ns, ioc);
+
+                    trees[i] = (ns.Name, CreateSyntaxTree(SingletonList(member)));
+                }
+            );
+        }
+        catch (AggregateException e)
+        {
+            // Rethrows the exception of a fatal error as is, the logger callers expect its own exception type
+            ExceptionDispatchInfo.Capture(e.Flatten().InnerExceptions[0]).Throw();
+        }
+
+        var moduleInitializer = GenerateModuleInitializer(csAssembly, ioc);
+        if (moduleInitializer.Length == 0)
+            return trees;
+
+        return trees.Append((null, CreateSyntaxTree(List(moduleInitializer)))).ToArray();
+    }
+
+    private static MemberDeclarationSyntax GenerateNamespace(CsNamespace ns, Ioc ioc)
+    {
         var generators = ioc.Generators;
 
-        logger.Message("Generating Roslyn syntax tree...");
+        MemberSyntaxList list = new(ioc);
+        list.AddRange(ns.Enums.OrderBy(element => element.Name), generators.Enum);
+        list.AddRange(ns.Structs.OrderBy(element => element.Name), generators.Struct);
+        list.AddRange(ns.Classes.OrderBy(element => element.Name), generators.Group);
+        list.AddRange(ns.Interfaces.OrderBy(element => element.Name), generators.Interface);
+        return NamespaceDeclaration(ParseName(ns.Name), default, default, List(list))
+           .WithLeadingTrivia(Comment(AutoGeneratedCommentText));
+    }
 
+    private MemberDeclarationSyntax[] GenerateModuleInitializer(CsAssembly csAssembly, Ioc ioc)
+    {
         var resultConstants = csAssembly.Namespaces
                                         .SelectMany(x => x.EnumerateDescendants<CsResultConstant>(withAdditionalItems: false))
                                         .ToArray();
 
-        var moduleInitializer = resultConstants.Length > 0
-                                    ? new[]
-                                    {
-                                        ClassDeclaration("ModuleDataInitializer")
-                                           .WithModifiers(ModuleInitModifiers)
-                                           .AddMembers(GenerateResultDescriptor(resultConstants, ioc))
-                                    }
-                                    : Enumerable.Empty<MemberDeclarationSyntax>();
+        return resultConstants.Length > 0
+                   ? new MemberDeclarationSyntax[]
+                   {
+                       ClassDeclaration(ModuleDataInitializerName)
+                          .WithModifiers(ModuleInitModifiers)
+                          .AddMembers(GenerateResultDescriptor(resultConstants, ioc))
+                   }
+                   : Array.Empty<MemberDeclarationSyntax>();
+    }
 
-        MemberDeclarationSyntax NamespaceSelector(CsNamespace ns)
-        {
-            MemberSyntaxList list = new(ioc);
-            list.AddRange(ns.Enums.OrderBy(element => element.Name), generators.Enum);
-            list.AddRange(ns.Structs.OrderBy(element => element.Name), generators.Struct);
-            list.AddRange(ns.Classes.OrderBy(element => element.Name), generators.Group);
-            list.AddRange(ns.Interfaces.OrderBy(element => element.Name), generators.Interface);
-            return NamespaceDeclaration(ParseName(ns.Name), default, default, List(list))
-               .WithLeadingTrivia(Comment(AutoGeneratedCommentText));
-        }
+    private static SyntaxTree CreateSyntaxTree(SyntaxList<MemberDeclarationSyntax> members)
+    {
+        using var phase = PhaseTrace.Begin("Normalize syntax");
 
         return CSharpSyntaxTree.Create(
             RoslynSyntaxNormalizer.Normalize(
-                CompilationUnit(
-                    default, default, default,
-                    List(csAssembly.Namespaces.Select(NamespaceSelector)).AddRange(moduleInitializer)
-                ),
+                CompilationUnit(default, default, default, members),
                 "    ",
                 "\r\n",
                 true
@@ -29,15 +29,31 @@ internal sealed class ShadowCallbackGenerator : MemberPlatformMultiCodeGenerator
     {
         var sig = csElement.InteropSignatures[platform];
 
-        var delegateDecl = GenerateDelegateDeclaration(csElement, platform, sig);
-        if (csElement is CsMethod { IsFunctionPointerInVtbl: true })
-            delegateDecl = delegateDecl.WithLeadingIfDirective(GeneratorHelpers.NotPreprocessorNameSyntax)
-                                       .WithTrailingElseDirective();
+        var isFunctionPointerInVtbl = IsFunctionPointerInVtbl(csElement, out var alwaysApplies);
+
+        if (!isFunctionPointerInVtbl)
+        {
+            yield return GenerateDelegateDeclaration(csElement, platform, sig);
+        }
+        else if (!alwaysApplies)
+        {
+            yield return GenerateDelegateDeclaration(csElement, platform, sig)
+                        .WithLeadingIfDirective(GeneratorHelpers.NotPreprocessorNameSyntax)
+                        .WithTrailingElseDirective();
+        }
 
-        yield return delegateDecl;
         yield return GenerateShadowCallback(csElement, platform, sig);
     }
 
+    private bool IsFunctionPointerInVtbl(CsCallable csElement, out bool alwaysApplies)
+    {
+        if (csElement is CsMethod method)
+            return VtblGenerator.IsFunctionPointerInVtbl(method, Generators.Config, out alwaysApplies);
+
+        alwaysApplies = false;
+        return false;
+    }
+
     private static DelegateDeclarationSyntax GenerateDelegateDeclaration(CsCallable csElement,
                                                                          PlatformDetectionType platform,
                                                                          InteropMethodSignature sig) =>
@@ -119,6 +135,27 @@ internal sealed class ShadowCallbackGenerator : MemberPlatformMultiCodeGenerator
     {
         var interopReturnType = sig.ReturnTypeSyntax;
 
+        var isFunctionPointerInVtbl = IsFunctionPointerInVtbl(csElement, out var alwaysApplies);
+
+        AttributeListSyntax UnmanagedCallersOnlyAttributeList()
+        {
+            var attributeList = AttributeList(
+                SingletonSeparatedList(
+                    Attribute(
+                        UnmanagedCallersOnlyAttributeName,
+                        AttributeArgumentList(
+                            SingletonSeparatedList(
+                                AttributeArgument(FnPtrCallConvs(sig.CallingConvention))
+                                   .WithNameEquals(NameEquals("CallConvs"))
+                            )
+                        )
+                    )
+                )
+            );
+
+            return alwaysApplies ? attributeList : attributeList.WithTrailingEndIfDirective();
+        }
+
         var methodDeclaration = MethodDeclaration(
                                           interopReturnType,
                                           VtblGenerator.GetMethodImplName(csElement, platform)
@@ -131,22 +168,8 @@ internal sealed class ShadowCallbackGenerator : MemberPlatformMultiCodeGenerator
                                       )
                                      .WithParameterList(GetNativeParameterList(csElement, sig))
                                      .WithAttributeLists(
-                                          csElement is CsMethod { IsFunctionPointerInVtbl: true }
-                                              ? SingletonList(
-                                                  AttributeList(
-                                                      SingletonSeparatedList(
-                                                          Attribute(
-                                                              UnmanagedCallersOnlyAttributeName,
-                                                              AttributeArgumentList(
-                                                                  SingletonSeparatedList(
-                                                                      AttributeArgument(FnPtrCallConvs(sig.CallingConvention))
-                                                                         .WithNameEquals(NameEquals("CallConvs"))
-                                                                  )
-                                                              )
-                                                          )
-                                                      )
-                                                  ).WithTrailingEndIfDirective()
-                                              )
+                                          isFunctionPointerInVtbl
+                                              ? SingletonList(UnmanagedCallersOnlyAttributeList())
                                               : default
                                       );
 
@@ -17,11 +17,6 @@ internal sealed class VtblGenerator : MemberSingleCodeGeneratorBase<CsInterface>
 
     public override MemberDeclarationSyntax GenerateCode(CsInterface csElement)
     {
-        var vtblClassName = csElement.VtblName.Split('.').Last();
-
-        // Default: at least protected to enable inheritance.
-        var vtblVisibility = csElement.VtblVisibility ?? Visibility.Internal;
-
         bool AnyOffsetDiffersPredicate()
         {
             bool Predicate(CsMethod x) => x.WindowsOffset != x.Offset ||
@@ -53,6 +48,18 @@ internal sealed class VtblGenerator : MemberSingleCodeGeneratorBase<CsInterface>
 
         var members = NewMemberList;
 
+        // Only the methods that can't be implemented without marshalling still need delegates
+        if (Generators.Config.FunctionPointerShadows)
+        {
+            foreach (var method in csElement.Methods.Where(x => !x.HasBlittableInteropSignature))
+                members.AddRange(method.InteropSignatures.Keys, platform => DelegateCacheDecl(method, platform));
+
+            members.Add(VtblDecl(MethodArrayBuilder(true)));
+            members.AddRange(csElement.Methods, Generators.ShadowCallable);
+
+            return VtblClassDecl(csElement, members);
+        }
+
         List<CsMethod> legacyMethods = new();
 
         foreach (var method in csElement.Methods)
@@ -113,6 +120,16 @@ internal sealed class VtblGenerator : MemberSingleCodeGeneratorBase<CsInterface>
 
         members.AddRange(csElement.Methods, Generators.ShadowCallable);
 
+        return VtblClassDecl(csElement, members);
+    }
+
+    private static ClassDeclarationSyntax VtblClassDecl(CsInterface csElement, IEnumerable<MemberDeclarationSyntax> members)
+    {
+        var vtblClassName = csElement.VtblName.Split('.').Last();
+
+        // Default: at least protected to enable inheritance.
+        var vtblVisibility = csElement.VtblVisibility ?? Visibility.Internal;
+
         return ClassDeclaration(vtblClassName)
               .WithModifiers(
                    ModelUtilities.VisibilityToTokenList(
@@ -123,6 +140,19 @@ internal sealed class VtblGenerator : MemberSingleCodeGeneratorBase<CsInterface>
               .WithMembers(List(members));
     }
 
+    /// <summary>
+    /// Whether the shadow method is an <c>UnmanagedCallersOnly</c> method referenced by the vtable,
+    /// instead of a delegate.
+    /// </summary>
+    /// <param name="method">The method.</param>
+    /// <param name="config">The generator configuration.</param>
+    /// <param name="alwaysApplies">Whether it applies unconditionally, or only to .NET 6 and later.</param>
+    internal static bool IsFunctionPointerInVtbl(CsMethod method, GeneratorConfig config, out bool alwaysApplies)
+    {
+        alwaysApplies = config.FunctionPointerShadows;
+        return alwaysApplies ? method.HasBlittableInteropSignature : method.IsFunctionPointerInVtbl;
+    }
+
     private ExpressionSyntax GetMarshalFunctionPointerForDelegate(CsMethod method,
                                                                   PlatformDetectionType platform) =>
         InvocationExpression(
@@ -213,7 +243,7 @@ internal sealed class VtblGenerator : MemberSingleCodeGeneratorBase<CsInterface>
             );
         }
 
-        return method.IsFunctionPointerInVtbl && withFunctionPointers
+        return IsFunctionPointerInVtbl(method, Generators.Config, out _) && withFunctionPointers
                    ? GeneratorHelpers.CastExpression(
                        GeneratorHelpers.IntPtrType,
                        GeneratorHelpers.CastExpression(
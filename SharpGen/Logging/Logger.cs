@@ -19,18 +19,24 @@
 // THE SOFTWARE.
 
 using System;
-using System.Collections.Generic;
+using System.Collections.Immutable;
+using System.Threading;
 
 namespace SharpGen.Logging;
 
 /// <summary>
-/// Root Logger class.
+/// Logger safe for concurrent use.
 /// </summary>
+/// <remarks>
+/// Contexts and locations are tracked per logical flow of execution: work items started in parallel
+/// inherit the contexts of the code starting them, and the contexts they push are only visible to themselves.
+/// </remarks>
 public sealed class Logger : LoggerBase
 {
     private int _errorCount;
-    private readonly List<string> contextStack = new();
-    private readonly Stack<LogLocation> fileLocationStack = new();
+    private readonly AsyncLocal<ImmutableList<string>> contextStack = new();
+    private readonly AsyncLocal<ImmutableStack<LogLocation>> fileLocationStack = new();
+    private readonly object outputLock = new();
 
     public Logger(ILogger output, IProgressReport progress = null)
     {
@@ -41,13 +47,25 @@ public sealed class Logger : LoggerBase
     /// <summary>
     /// Gets the context as a string.
     /// </summary>
-    private string ContextAsText => HasContext ? string.Join("/", contextStack) : null;
+    private string ContextAsText => HasContext ? string.Join("/", Contexts) : null;
+
+    private ImmutableList<string> Contexts
+    {
+        get => contextStack.Value ?? ImmutableList<string>.Empty;
+        set => contextStack.Value = value;
+    }
+
+    private ImmutableStack<LogLocation> FileLocations
+    {
+        get => fileLocationStack.Value ?? ImmutableStack<LogLocation>.Empty;
+        set => fileLocationStack.Value = value;
+    }
 
     public override ILogger LoggerOutput { get; }
 
-    private bool HasContext => contextStack.Count > 0;
+    private bool HasContext => !Contexts.IsEmpty;
 
-    public override bool HasErrors => _errorCount > 0;
+    public override bool HasErrors => Volatile.Read(ref _errorCount) > 0;
 
     public override IProgressReport ProgressReport { get; }
 
@@ -56,7 +74,7 @@ public sealed class Logger : LoggerBase
     /// </summary>
     public override void PushContext(string context)
     {
-        contextStack.Add(context);
+        Contexts = Contexts.Add(context);
     }
 
     /// <summary>
@@ -64,7 +82,7 @@ public sealed class Logger : LoggerBase
     /// </summary>
     public override void PushLocation(string fileName, int line = 1, int column = 1)
     {
-        fileLocationStack.Push(new LogLocation(fileName, line, column));
+        FileLocations = FileLocations.Push(new LogLocation(fileName, line, column));
     }
 
     /// <summary>
@@ -72,7 +90,7 @@ public sealed class Logger : LoggerBase
     /// </summary>
     public override void PopLocation()
     {
-        fileLocationStack.Pop();
+        FileLocations = FileLocations.Pop();
     }
 
     /// <summary>
@@ -80,7 +98,7 @@ public sealed class Logger : LoggerBase
     /// </summary>
     public override void PushContext(string context, params object[] parameters)
     {
-        contextStack.Add(string.Format(context, parameters));
+        Contexts = Contexts.Add(string.Format(context, parameters));
     }
 
     /// <summary>
@@ -88,8 +106,9 @@ public sealed class Logger : LoggerBase
     /// </summary>
     public override void PopContext()
     {
-        if (contextStack.Count > 0)
-            contextStack.RemoveAt(contextStack.Count - 1);
+        var contexts = Contexts;
+        if (!contexts.IsEmpty)
+            Contexts = contexts.RemoveAt(contexts.Count - 1);
     }
 
     /// <summary>
@@ -117,14 +136,20 @@ public sealed class Logger : LoggerBase
     /// </summary>
     public override void LogRawMessage(LogLevel type, string code, string message, Exception exception, params object[] parameters)
     {
-        var logLocation = fileLocationStack.Count > 0 ? fileLocationStack.Peek() : null;
+        var fileLocations = FileLocations;
+        var logLocation = fileLocations.IsEmpty ? null : fileLocations.Peek();
 
         if (LoggerOutput == null)
+        {
             Console.WriteLine("Warning, unable to log error. No LoggerOutput configured");
+        }
         else
-            LoggerOutput.Log(type, logLocation, ContextAsText, code, message, exception, parameters);
+        {
+            lock (outputLock)
+                LoggerOutput.Log(type, logLocation, ContextAsText, code, message, exception, parameters);
+        }
 
         if (type is LogLevel.Error or LogLevel.Fatal)
-            _errorCount++;
+            Interlocked.Increment(ref _errorCount);
     }
 }
\ No newline at end of file
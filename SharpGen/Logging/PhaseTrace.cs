@@ -0,0 +1,101 @@
+#nullable enable
+
+using System;
+using System.Diagnostics;
+using System.Reflection;
+using System.Threading;
+
+namespace SharpGen.Logging;
+
+/// <summary>
+/// Instrumentation of the phases of the SharpGen pipeline.
+/// </summary>
+/// <remarks>
+/// Phases are reported to the <c>SharpGen</c> event source and, when set, to the <see cref="Recorder"/>
+/// of the current flow of execution, which includes the work items it starts in parallel.
+/// </remarks>
+public static class PhaseTrace
+{
+    private static readonly AsyncLocal<TraceRecorder?> CurrentRecorder = new();
+    private static readonly Func<bool, long>? GetTotalAllocatedBytes = CreateGetTotalAllocatedBytes();
+
+    /// <summary>
+    /// Gets or sets the recorder receiving the phases of the current flow of execution.
+    /// </summary>
+    public static TraceRecorder? Recorder
+    {
+        get => CurrentRecorder.Value;
+        set => CurrentRecorder.Value = value;
+    }
+
+    /// <summary>
+    /// Starts a phase, ended when the returned scope is disposed.
+    /// </summary>
+    /// <param name="phase">The name of the phase.</param>
+    public static Scope Begin(string phase)
+    {
+        var recorder = Recorder;
+        var eventSource = SharpGenEventSource.Log;
+
+        if (recorder == null && !eventSource.IsEnabled())
+            return default;
+
+        if (eventSource.IsEnabled())
+            eventSource.PhaseStart(phase);
+
+        return new Scope(phase, recorder, Stopwatch.GetTimestamp(), AllocatedBytes);
+    }
+
+    /// <summary>
+    /// Gets the number of bytes allocated by the process, <c>-1</c> when the runtime doesn't report it.
+    /// </summary>
+    private static long AllocatedBytes => GetTotalAllocatedBytes?.Invoke(false) ?? -1;
+
+    private static Func<bool, long>? CreateGetTotalAllocatedBytes()
+    {
+        // Only available starting with .NET Core 3.0
+        var method = typeof(GC).GetMethod(
+            "GetTotalAllocatedBytes", BindingFlags.Public | BindingFlags.Static, null, new[] { typeof(bool) }, null
+        );
+
+        return method != null ? (Func<bool, long>) Delegate.CreateDelegate(typeof(Func<bool, long>), method) : null;
+    }
+
+    /// <summary>
+    /// A running phase.
+    /// </summary>
+    public readonly struct Scope : IDisposable
+    {
+        private readonly string? phase;
+        private readonly TraceRecorder? recorder;
+        private readonly long startTimestamp;
+        private readonly long startAllocatedBytes;
+
+        internal Scope(string phase, TraceRecorder? recorder, long startTimestamp, long startAllocatedBytes)
+        {
+            this.phase = phase;
+            this.recorder = recorder;
+            this.startTimestamp = startTimestamp;
+            this.startAllocatedBytes = startAllocatedBytes;
+        }
+
+        public void Dispose()
+        {
+            if (phase == null)
+                return;
+
+            var endTimestamp = Stopwatch.GetTimestamp();
+            var allocatedBytes = startAllocatedBytes >= 0 ? AllocatedBytes - startAllocatedBytes : -1;
+
+            recorder?.Add(phase, startTimestamp, endTimestamp, allocatedBytes);
+
+            var eventSource = SharpGenEventSource.Log;
+            if (eventSource.IsEnabled())
+            {
+                eventSource.PhaseStop(
+                    phase, (endTimestamp - startTimestamp) * 1000.0 / Stopwatch.Frequency, allocatedBytes
+                );
+            }
+        }
+    }
+}
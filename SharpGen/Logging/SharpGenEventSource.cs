@@ -0,0 +1,25 @@
+#nullable enable
+
+using System.Diagnostics.Tracing;
+
+namespace SharpGen.Logging;
+
+/// <summary>
+/// Events of the SharpGen pipeline phases, for ETW/EventPipe tools (<c>dotnet-trace</c>, PerfView).
+/// </summary>
+[EventSource(Name = "SharpGen")]
+internal sealed class SharpGenEventSource : EventSource
+{
+    public static readonly SharpGenEventSource Log = new();
+
+    private SharpGenEventSource()
+    {
+    }
+
+    [Event(1, Level = EventLevel.Informational)]
+    public void PhaseStart(string phase) => WriteEvent(1, phase);
+
+    [Event(2, Level = EventLevel.Informational)]
+    public void PhaseStop(string phase, double durationMilliseconds, long allocatedBytes) =>
+        WriteEvent(2, phase, durationMilliseconds, allocatedBytes);
+}
@@ -0,0 +1,126 @@
+#nullable enable
+
+using System;
+using System.Collections.Concurrent;
+using System.Diagnostics;
+using System.Globalization;
+using System.IO;
+using System.Linq;
+using System.Text;
+
+namespace SharpGen.Logging;
+
+/// <summary>
+/// Records the phases reported by <see cref="PhaseTrace"/>, to write them as a Chrome trace.
+/// </summary>
+/// <remarks>
+/// The trace can be opened in <c>chrome://tracing</c> or <c>https://ui.perfetto.dev</c>.
+/// The allocated bytes of a phase are counted for the whole process, so they include the allocations
+/// of the phases running concurrently.
+/// </remarks>
+public sealed class TraceRecorder
+{
+    private readonly ConcurrentQueue<Record> records = new();
+    private readonly long originTimestamp = Stopwatch.GetTimestamp();
+
+    private readonly struct Record
+    {
+        public Record(string phase, long start, long end, long allocatedBytes, int threadId)
+        {
+            Phase = phase;
+            Start = start;
+            End = end;
+            AllocatedBytes = allocatedBytes;
+            ThreadId = threadId;
+        }
+
+        public string Phase { get; }
+        public long Start { get; }
+        public long End { get; }
+        public long AllocatedBytes { get; }
+        public int ThreadId { get; }
+    }
+
+    internal void Add(string phase, long startTimestamp, long endTimestamp, long allocatedBytes) =>
+        records.Enqueue(
+            new Record(phase, startTimestamp, endTimestamp, allocatedBytes, Environment.CurrentManagedThreadId)
+        );
+
+    /// <summary>
+    /// Writes the recorded phases in the Chrome trace event format.
+    /// </summary>
+    public void WriteChromeTrace(TextWriter writer)
+    {
+        var processId = Process.GetCurrentProcess().Id;
+
+        writer.WriteLine("{\"traceEvents\":[");
+
+        var first = true;
+        foreach (var record in records.OrderBy(x => x.Start).ThenByDescending(x => x.End))
+        {
+            if (!first)
+                writer.WriteLine(',');
+            first = false;
+
+            writer.Write("{\"name\":");
+            WriteString(writer, record.Phase);
+            writer.Write(",\"cat\":\"SharpGen\",\"ph\":\"X\",\"ts\":");
+            writer.Write(ToMicroseconds(record.Start - originTimestamp));
+            writer.Write(",\"dur\":");
+            writer.Write(ToMicroseconds(record.End - record.Start));
+            writer.Write(",\"pid\":");
+            writer.Write(processId.ToString(CultureInfo.InvariantCulture));
+            writer.Write(",\"tid\":");
+            writer.Write(record.ThreadId.ToString(CultureInfo.InvariantCulture));
+
+            if (record.AllocatedBytes >= 0)
+            {
+                writer.Write(",\"args\":{\"allocatedBytes\":");
+                writer.Write(record.AllocatedBytes.ToString(CultureInfo.InvariantCulture));
+                writer.Write('}');
+            }
+
+            writer.Write('}');
+        }
+
+        writer.WriteLine();
+        writer.WriteLine("]}");
+    }
+
+    /// <summary>
+    /// Writes the recorded phases in the Chrome trace event format.
+    /// </summary>
+    public void WriteChromeTrace(string path)
+    {
+        using var writer = new StreamWriter(path, false, new UTF8Encoding(false));
+        WriteChromeTrace(writer);
+    }
+
+    private static string ToMicroseconds(long timestampDelta) =>
+        (timestampDelta * 1_000_000.0 / Stopwatch.Frequency).ToString("0.###", CultureInfo.InvariantCulture);
+
+    private static void WriteString(TextWriter writer, string value)
+    {
+        writer.Write('"');
+        foreach (var c in value)
+        {
+            switch (c)
+            {
+                case '"':
+                    writer.Write("\\\"");
+                    break;
+                case '\\':
+                    writer.Write("\\\\");
+                    break;
+                case < ' ':
+                    writer.Write("\\u");
+                    writer.Write(((int) c).ToString("x4", CultureInfo.InvariantCulture));
+                    break;
+                default:
+                    writer.Write(c);
+                    break;
+            }
+        }
+        writer.Write('"');
+    }
+}
@@ -74,26 +74,27 @@ public sealed class CsMethod : CsCallable
         );
     }
 
-    public bool IsFunctionPointerInVtbl
+    public bool IsFunctionPointerInVtbl => Parameters.All(IsBlittable) && IsBlittable(ReturnValue);
+
+    /// <summary>
+    /// Whether the native signature of this method only has blittable types, so that an
+    /// <c>UnmanagedCallersOnly</c> method can implement it. The values passed by pointer are,
+    /// whatever their marshalling is.
+    /// </summary>
+    public bool HasBlittableInteropSignature =>
+        Parameters.All(x => x.HasPointer || IsBlittable(x)) && (ReturnValue.HasPointer || IsBlittable(ReturnValue));
+
+    private static bool IsBlittable(CsMarshalCallableBase x)
     {
-        get
+        var marshalType = x.MarshalType;
+
+        if (marshalType is { IsBlittable: true })
+            return true;
+
+        return !x.IsArray && !x.HasPointer && !x.IsString && marshalType is CsFundamentalType
         {
-            static bool IsBlittable(CsMarshalCallableBase x)
-            {
-                var marshalType = x.MarshalType;
-
-                if (marshalType is { IsBlittable: true })
-                    return true;
-
-                return !x.IsArray && !x.HasPointer && !x.IsString && marshalType is CsFundamentalType
-                {
-                    PrimitiveTypeIdentity: { Type: PrimitiveTypeCode.Char, PointerCount: 0 }
-                };
-            }
-
-            return Parameters.All(IsBlittable)
-                && IsBlittable(ReturnValue);
-        }
+            PrimitiveTypeIdentity: { Type: PrimitiveTypeCode.Char, PointerCount: 0 }
+        };
     }
 
     public bool IsPublicVisibilityForced(CsInterface parentInterface)
@@ -0,0 +1,35 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+
+namespace SharpGen.Parser;
+
+/// <summary>
+/// A self-contained part of the C++ headers, processed by its own CastXML invocation.
+/// </summary>
+public sealed class CastXmlShard
+{
+    public CastXmlShard(string headerFile, IEnumerable<string> includeIds)
+    {
+        HeaderFile = headerFile ?? throw new ArgumentNullException(nameof(headerFile));
+        IncludeIds = new HashSet<string>(
+            includeIds ?? throw new ArgumentNullException(nameof(includeIds)),
+            StringComparer.InvariantCultureIgnoreCase
+        );
+    }
+
+    /// <summary>
+    /// Gets the header file passed to CastXML.
+    /// </summary>
+    public string HeaderFile { get; }
+
+    /// <summary>
+    /// Gets the includes owned by this shard.
+    /// </summary>
+    /// <remarks>
+    /// The header of a shard may pull includes owned by other shards, those are ignored when parsing the shard,
+    /// so that each C++ element is parsed once.
+    /// </remarks>
+    public ISet<string> IncludeIds { get; }
+}
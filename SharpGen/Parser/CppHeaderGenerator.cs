@@ -11,7 +11,12 @@ namespace SharpGen.Parser;
 public sealed class CppHeaderGenerator
 {
     private readonly Ioc ioc;
-    private const string Version = "1.1";
+    private const string Version = "1.2";
+
+    /// <summary>
+    /// The macro defined while only preprocessing the headers, which excludes the extension headers.
+    /// </summary>
+    public const string PreprocessOnlyMacro = "__SHARPGEN_PREPROCESS_ONLY__";
 
     private Logger Logger => ioc.Logger;
     private string OutputPath { get; }
@@ -73,6 +78,190 @@ public sealed class CppHeaderGenerator
         return new Result(updatedConfigs, prologue);
     }
 
+    /// <summary>
+    /// Generates the header used to run CastXML on the translation unit already preprocessed for the macros.
+    /// </summary>
+    /// <param name="configRoot">The root config file.</param>
+    /// <param name="configsWithExtensionHeaders">The config files with an extension header.</param>
+    /// <param name="preprocessedFile">The preprocessed translation unit of the root config header.</param>
+    /// <returns>The path of the generated header.</returns>
+    /// <remarks>
+    /// The extension headers are excluded from the preprocessed translation unit, they are included at its end,
+    /// once all the macros they refer to are defined.
+    /// </remarks>
+    public string GenerateSinglePassHeader(ConfigFile configRoot, ISet<ConfigFile> configsWithExtensionHeaders,
+                                           string preprocessedFile)
+    {
+        var singlePassHeader = Path.Combine(OutputPath, configRoot.Id + "-single.h");
+
+        using StringWriter contents = new();
+        contents.WriteLine("// SharpGen single pass [{0}] - Version {1}", configRoot.Id, Version);
+        contents.WriteLine("#include \"{0}\"", Path.GetFileName(preprocessedFile));
+
+        foreach (var configFile in configRoot.ConfigFilesLoaded)
+        {
+            if (!configsWithExtensionHeaders.Contains(configFile))
+                continue;
+
+            contents.WriteLine("#if __has_include(\"{0}\")", configFile.ExtensionFileName);
+            contents.WriteLine("#include \"{0}\"", configFile.ExtensionFileName);
+            contents.WriteLine("#endif");
+        }
+
+        var contentsString = contents.ToString();
+        if (!File.Exists(singlePassHeader) || contentsString != File.ReadAllText(singlePassHeader))
+            File.WriteAllText(singlePassHeader, contentsString, Encoding.UTF8);
+
+        return singlePassHeader;
+    }
+
+    /// <summary>
+    /// Generates the headers used to run CastXML on each config file separately.
+    /// </summary>
+    /// <remarks>
+    /// Each shard includes the prologue, the includes and extension headers of the config files referenced
+    /// (transitively) by a config file owning some, then its own includes and extension header.
+    /// Only the own includes of the config file are parsed from its shard,
+    /// the referenced config files are parsed from their own shards.
+    /// </remarks>
+    public IReadOnlyList<CastXmlShard> GenerateShardHeaders(IReadOnlyCollection<ConfigFile> configsWithIncludes,
+                                                            ISet<ConfigFile> configsWithExtensionHeaders,
+                                                            string prologue)
+    {
+        List<CastXmlShard> shards = new();
+
+        foreach (var configFile in configsWithIncludes)
+        {
+            var hasExtensionHeader = configsWithExtensionHeaders.Contains(configFile);
+            if (configFile.Includes.Count == 0 && !hasExtensionHeader)
+                continue;
+
+            var includeIds = configFile.Includes.Select(static include => include.Id);
+            if (hasExtensionHeader)
+                includeIds = includeIds.Append(configFile.ExtensionId);
+
+            var shardHeader = Path.Combine(OutputPath, configFile.Id + "-shard.h");
+
+            using StringWriter shardContents = new();
+            shardContents.WriteLine("// SharpGen shard [{0}] - Version {1}", configFile.Id, Version);
+            shardContents.Write(prologue);
+
+            // The headers of a config file may depend on the types of the config files it references
+            HashSet<string> visitedConfigs = new() { configFile.Id };
+            foreach (var reference in configFile.References)
+                WriteReferencedIncludes(shardContents, reference, configsWithIncludes, configsWithExtensionHeaders,
+                                        visitedConfigs);
+
+            WriteIncludes(shardContents, configFile);
+
+            if (hasExtensionHeader)
+                WriteExtensionHeaderInclude(shardContents, configFile);
+
+            var shardContentsString = shardContents.ToString();
+            if (!File.Exists(shardHeader) || shardContentsString != File.ReadAllText(shardHeader))
+                File.WriteAllText(shardHeader, shardContentsString, Encoding.UTF8);
+
+            shards.Add(new CastXmlShard(shardHeader, includeIds));
+        }
+
+        return shards;
+    }
+
+    private static void WriteReferencedIncludes(TextWriter outputConfig, ConfigFile configFile,
+                                                IReadOnlyCollection<ConfigFile> configsWithIncludes,
+                                                ISet<ConfigFile> configsWithExtensionHeaders,
+                                                HashSet<string> visitedConfigs)
+    {
+        // Same references as the config headers, without repeating the headers shared by several references
+        if (!configsWithIncludes.Contains(configFile) || !visitedConfigs.Add(configFile.Id))
+            return;
+
+        foreach (var reference in configFile.References)
+            WriteReferencedIncludes(outputConfig, reference, configsWithIncludes, configsWithExtensionHeaders,
+                                    visitedConfigs);
+
+        WriteIncludes(outputConfig, configFile);
+
+        if (configsWithExtensionHeaders.Contains(configFile))
+            WriteExtensionHeaderInclude(outputConfig, configFile);
+    }
+
+    /// <summary>
+    /// Generates the header precompiled for the CastXML runs on the root config header.
+    /// </summary>
+    /// <param name="configRoot">The root config file.</param>
+    /// <param name="configsWithIncludes">The config files with includes.</param>
+    /// <param name="configsWithExtensionHeaders">The config files with an extension header.</param>
+    /// <param name="prologue">The prologue of the config headers.</param>
+    /// <param name="isSystemInclude">Determines whether an include file is found in a system include directory.</param>
+    /// <returns>The path of the generated header, or <c>null</c> if the root config header doesn't start with system includes.</returns>
+    /// <remarks>
+    /// The header is the prologue followed by the system includes starting the translation unit of the root config header,
+    /// up to the first include of the project, include with custom code or extension header.
+    /// The translation unit then starts the same way with or without the precompiled header.
+    /// </remarks>
+    public string GeneratePrecompiledHeader(ConfigFile configRoot, IReadOnlyCollection<ConfigFile> configsWithIncludes,
+                                            ISet<ConfigFile> configsWithExtensionHeaders, string prologue,
+                                            Func<string, bool> isSystemInclude)
+    {
+        List<string> includes = new();
+        CollectLeadingSystemIncludes(
+            configRoot, configsWithIncludes, configsWithExtensionHeaders, isSystemInclude,
+            new HashSet<string>(), includes
+        );
+
+        if (includes.Count == 0)
+            return null;
+
+        var precompiledHeader = Path.Combine(OutputPath, configRoot.Id + "-pch.h");
+
+        using StringWriter contents = new();
+        contents.WriteLine("// SharpGen precompiled header [{0}] - Version {1}", configRoot.Id, Version);
+        contents.Write(prologue);
+
+        foreach (var include in includes)
+            contents.WriteLine("#include \"{0}\"", include);
+
+        var contentsString = contents.ToString();
+        if (!File.Exists(precompiledHeader) || contentsString != File.ReadAllText(precompiledHeader))
+            File.WriteAllText(precompiledHeader, contentsString, Encoding.UTF8);
+
+        return precompiledHeader;
+    }
+
+    /// <returns><c>true</c> if the includes following <paramref name="configFile"/> can still be collected.</returns>
+    private static bool CollectLeadingSystemIncludes(ConfigFile configFile,
+                                                     IReadOnlyCollection<ConfigFile> configsWithIncludes,
+                                                     ISet<ConfigFile> configsWithExtensionHeaders,
+                                                     Func<string, bool> isSystemInclude,
+                                                     HashSet<string> visitedConfigs, List<string> includes)
+    {
+        // The config headers have no include guard
+        if (!visitedConfigs.Add(configFile.Id))
+            return false;
+
+        foreach (var includeRule in configFile.Includes)
+        {
+            if (!string.IsNullOrEmpty(includeRule.Pre) || !string.IsNullOrEmpty(includeRule.Post) ||
+                !isSystemInclude(includeRule.File))
+                return false;
+
+            includes.Add(includeRule.File);
+        }
+
+        foreach (var reference in configFile.References)
+        {
+            if (!configsWithIncludes.Contains(reference))
+                continue;
+
+            if (!CollectLeadingSystemIncludes(reference, configsWithIncludes, configsWithExtensionHeaders,
+                                              isSystemInclude, visitedConfigs, includes))
+                return false;
+        }
+
+        return !configsWithExtensionHeaders.Contains(configFile);
+    }
+
     private static string GeneratePrologue(ConfigFile configRoot)
     {
         var prolog = new StringBuilder();
@@ -99,7 +288,23 @@ public sealed class CppHeaderGenerator
         if (configRoot.Id == configFile.Id)
             outputConfig.Write(prolog);
 
-        // Write includes
+        WriteIncludes(outputConfig, configFile);
+
+        // Write includes to references
+        foreach (var reference in configFile.References)
+        {
+            if (configsWithIncludes.Contains(reference))
+                outputConfig.WriteLine("#include \"{0}\"", reference.HeaderFileName);
+        }
+
+        if (configsWithExtensionHeaders.Contains(configFile))
+            WriteExtensionHeaderInclude(outputConfig, configFile);
+
+        return outputConfig.ToString();
+    }
+
+    private static void WriteIncludes(TextWriter outputConfig, ConfigFile configFile)
+    {
         foreach (var includeRule in configFile.Includes)
         {
             if (!string.IsNullOrEmpty(includeRule.Pre))
@@ -114,30 +319,24 @@ public sealed class CppHeaderGenerator
                 outputConfig.WriteLine(includeRule.Post);
             }
         }
+    }
 
-        // Write includes to references
-        foreach (var reference in configFile.References)
-        {
-            if (configsWithIncludes.Contains(reference))
-                outputConfig.WriteLine("#include \"{0}\"", reference.HeaderFileName);
-        }
-
+    private static void WriteExtensionHeaderInclude(TextWriter outputConfig, ConfigFile configFile)
+    {
         // Dump Create from macros
-        if (configsWithExtensionHeaders.Contains(configFile))
+        foreach (var typeBaseRule in configFile.Extension)
         {
-            foreach (var typeBaseRule in configFile.Extension)
-            {
-                if (typeBaseRule.GeneratesExtensionHeader())
-                    outputConfig.WriteLine("// {0}", typeBaseRule);
-            }
-
-            // Include extension header if it exists
-            // so we can generate extension headers without needing them to already exist.
-            outputConfig.WriteLine("#if __has_include(\"{0}\")", configFile.ExtensionFileName);
-            outputConfig.WriteLine("#include \"{0}\"", configFile.ExtensionFileName);
-            outputConfig.WriteLine("#endif");
+            if (typeBaseRule.GeneratesExtensionHeader())
+                outputConfig.WriteLine("// {0}", typeBaseRule);
         }
 
-        return outputConfig.ToString();
+        // Include extension header if it exists
+        // so we can generate extension headers without needing them to already exist.
+        // The extension headers are generated from the macros: keep their previous version out of the macro pass.
+        outputConfig.WriteLine(
+            "#if !defined({0}) && __has_include(\"{1}\")", PreprocessOnlyMacro, configFile.ExtensionFileName
+        );
+        outputConfig.WriteLine("#include \"{0}\"", configFile.ExtensionFileName);
+        outputConfig.WriteLine("#endif");
     }
 }
\ No newline at end of file
@@ -15,6 +15,14 @@ public interface ICastXmlRunner
     /// <param name="handler">The handler.</param>
     void Preprocess(string headerFile, CastXmlPreprocessedLineReceivedEventHandler handler);
 
+    /// <summary>
+    /// Preprocesses the specified header file and writes the preprocessed translation unit to a file.
+    /// </summary>
+    /// <param name="headerFile">The header file.</param>
+    /// <param name="preprocessedFile">The file receiving the preprocessed translation unit.</param>
+    /// <param name="handler">The handler.</param>
+    void Preprocess(string headerFile, string preprocessedFile, CastXmlPreprocessedLineReceivedEventHandler handler);
+
     /// <summary>
     /// Processes the specified header headerFile.
     /// </summary>
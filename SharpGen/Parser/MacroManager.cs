@@ -57,7 +57,24 @@ public sealed class MacroManager
     public void Parse(string file, CppModule group)
     {
         _gccxml.Preprocess(file, ParseLine);
+        AddMacros(group);
+    }
 
+    /// <summary>
+    /// Parses the specified C++ header file and fills the <see cref="CppModule"/> with defined macros,
+    /// keeping the preprocessed translation unit for <see cref="CppHeaderGenerator.GenerateSinglePassHeader"/>.
+    /// </summary>
+    /// <param name="file">The C++ header file to parse.</param>
+    /// <param name="preprocessedFile">The file receiving the preprocessed translation unit.</param>
+    /// <param name="group">The CppModule object to fill with macro definitions.</param>
+    public void Parse(string file, string preprocessedFile, CppModule group)
+    {
+        _gccxml.Preprocess(file, preprocessedFile, ParseLine);
+        AddMacros(group);
+    }
+
+    private void AddMacros(CppModule group)
+    {
         foreach (var includeName in _mapIncludeToMacros.Keys)
         {
             var includeId = Path.GetFileNameWithoutExtension(includeName);
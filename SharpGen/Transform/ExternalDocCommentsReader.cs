@@ -1,47 +1,109 @@
-﻿using System.Collections.Generic;
+﻿using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
 using System.Xml;
 using SharpGen.Model;
 
 namespace SharpGen.Transform;
 
+/// <summary>
+/// Finds the external documentation file commenting an element.
+/// </summary>
+/// <remarks>
+/// The comment ids of all the files are indexed once, the first file commenting an id wins.
+/// </remarks>
 public class ExternalDocCommentsReader
 {
+    private readonly Dictionary<string, string> documentByCommentId = new(StringComparer.Ordinal);
+
     public static string GetCodeCommentsXPath(CsBase element)
     {
         return $"/comments/comment[@id='{GetExternalDocCommentId(element)}']";
     }
 
     public ExternalDocCommentsReader(Dictionary<string, XmlDocument> externalCommentsDocuments)
+        : this(externalCommentsDocuments.Select(x => (x.Key, ReadCommentIds(x.Value))))
     {
-        ExternalCommentsDocuments = externalCommentsDocuments;
     }
 
-    private Dictionary<string, XmlDocument> ExternalCommentsDocuments { get; }
+    /// <param name="externalComments">The external documentation files, with the ids of their comments.</param>
+    public ExternalDocCommentsReader(IEnumerable<(string File, IEnumerable<string> CommentIds)> externalComments)
+    {
+        foreach (var (file, commentIds) in externalComments)
+        {
+            foreach (var commentId in commentIds)
+            {
+                if (!documentByCommentId.ContainsKey(commentId))
+                    documentByCommentId.Add(commentId, file);
+            }
+        }
+    }
 
     public string GetDocumentWithExternalComments(CsBase element)
     {
-        string externalDocCommentId = GetExternalDocCommentId(element);
-        foreach (var document in ExternalCommentsDocuments)
+        return documentByCommentId.TryGetValue(GetExternalDocCommentId(element), out var document)
+                   ? document
+                   : null;
+    }
+
+    /// <summary>
+    /// Reads the ids of the <c>/comments/comment</c> elements of an external documentation file,
+    /// without loading the whole document.
+    /// </summary>
+    public static List<string> ReadCommentIds(Stream stream)
+    {
+        List<string> commentIds = new();
+
+        XmlReaderSettings settings = new()
         {
-            foreach (XmlNode topLevelNode in document.Value.ChildNodes)
+            DtdProcessing = DtdProcessing.Ignore,
+            IgnoreComments = true,
+            IgnoreProcessingInstructions = true,
+            IgnoreWhitespace = true
+        };
+
+        using var reader = XmlReader.Create(stream, settings);
+
+        if (reader.MoveToContent() != XmlNodeType.Element || reader.Name != "comments")
+            return commentIds;
+
+        reader.Read();
+
+        while (!reader.EOF && reader.Depth >= 1)
+        {
+            if (reader.NodeType != XmlNodeType.Element)
+            {
+                reader.Read();
+                continue;
+            }
+
+            if (reader.Depth == 1 && reader.Name == "comment" && reader.GetAttribute("id") is { } id)
+                commentIds.Add(id);
+
+            reader.Skip();
+        }
+
+        return commentIds;
+    }
+
+    private static IEnumerable<string> ReadCommentIds(XmlDocument document)
+    {
+        foreach (XmlNode topLevelNode in document.ChildNodes)
+        {
+            if (topLevelNode.Name != "comments")
+                continue;
+
+            foreach (XmlNode node in topLevelNode.ChildNodes)
             {
-                if (topLevelNode.Name == "comments")
-                {
-                    foreach (XmlNode node in topLevelNode.ChildNodes)
-                    {
-                        if (node.Name == "comment" && node.Attributes["id"].Value == externalDocCommentId)
-                        {
-                            return document.Key;
-                        }
-                    }
-                }
+                if (node.Name == "comment" && node.Attributes?["id"] is { } id)
+                    yield return id.Value;
             }
         }
-        return null;
     }
 
     private static string GetExternalDocCommentId(CsBase element)
     {
         return element.CppElementFullName ?? element.QualifiedName;
     }
-}
\ No newline at end of file
+}
@@ -1,5 +1,6 @@
 ﻿using System;
 using System.Collections.Generic;
+using System.Linq;
 using System.Text.RegularExpressions;
 using SharpGen.CppModel;
 using SharpGen.Logging;
@@ -12,9 +13,18 @@ public sealed class NamespaceRegistry
     private readonly Dictionary<string, CsNamespace> _mapIncludeToNamespace = new(StringComparer.InvariantCultureIgnoreCase);
     private readonly Dictionary<Regex, CsNamespace> _mapTypeToNamespace = new();
     private readonly Dictionary<string, CsNamespace> _namespaces = new();
+    private readonly object syncRoot = new();
     private readonly Ioc ioc;
 
-    public IEnumerable<CsNamespace> Namespaces => _namespaces.Values;
+    public IEnumerable<CsNamespace> Namespaces
+    {
+        get
+        {
+            lock (syncRoot)
+                return _namespaces.Values.ToArray();
+        }
+    }
+
     private Logger Logger => ioc.Logger;
 
     public NamespaceRegistry(Ioc ioc)
@@ -27,12 +37,15 @@ public sealed class NamespaceRegistry
     /// </summary>
     public CsNamespace GetOrCreateNamespace(string namespaceName)
     {
-        if (_namespaces.TryGetValue(namespaceName, out var selectedNamespace))
-            return selectedNamespace;
+        lock (syncRoot)
+        {
+            if (_namespaces.TryGetValue(namespaceName, out var selectedNamespace))
+                return selectedNamespace;
 
-        selectedNamespace = new CsNamespace(namespaceName);
-        _namespaces.Add(namespaceName, selectedNamespace);
-        return selectedNamespace;
+            selectedNamespace = new CsNamespace(namespaceName);
+            _namespaces.Add(namespaceName, selectedNamespace);
+            return selectedNamespace;
+        }
     }
 
     /// <summary>
@@ -42,7 +55,10 @@ public sealed class NamespaceRegistry
     /// <param name="nameSpace">The namespace.</param>
     public void MapIncludeToNamespace(string includeName, string nameSpace)
     {
-        _mapIncludeToNamespace.Add(includeName, GetOrCreateNamespace(nameSpace));
+        var csNamespace = GetOrCreateNamespace(nameSpace);
+
+        lock (syncRoot)
+            _mapIncludeToNamespace.Add(includeName, csNamespace);
     }
 
     /// <summary>
@@ -52,20 +68,27 @@ public sealed class NamespaceRegistry
     /// <param name="namespaceName">The namespace.</param>
     public void AttachTypeToNamespace(string typeNameRegex, string namespaceName)
     {
-        _mapTypeToNamespace.Add(new Regex(typeNameRegex), GetOrCreateNamespace(namespaceName));
+        var csNamespace = GetOrCreateNamespace(namespaceName);
+
+        lock (syncRoot)
+            _mapTypeToNamespace.Add(new Regex(typeNameRegex), csNamespace);
     }
 
     private bool TryGetNamespaceForInclude(string includeName, out CsNamespace cSharpNamespace)
     {
-        return _mapIncludeToNamespace.TryGetValue(includeName, out cSharpNamespace);
+        lock (syncRoot)
+            return _mapIncludeToNamespace.TryGetValue(includeName, out cSharpNamespace);
     }
 
     private (bool match, CsNamespace nameSpace) GetCsNamespaceForCppElement(CppElement element)
     {
-        foreach (var regExp in _mapTypeToNamespace)
+        lock (syncRoot)
         {
-            if (regExp.Key.Match(element.Name).Success)
-                return (true, regExp.Value);
+            foreach (var regExp in _mapTypeToNamespace)
+            {
+                if (regExp.Key.Match(element.Name).Success)
+                    return (true, regExp.Value);
+            }
         }
         return (false, default);
     }
@@ -22,6 +22,8 @@ using System;
 using System.Collections.Generic;
 using System.IO;
 using System.Linq;
+using System.Runtime.ExceptionServices;
+using System.Threading.Tasks;
 using SharpGen.Config;
 using SharpGen.CppModel;
 using SharpGen.Logging;
@@ -61,6 +63,18 @@ public sealed class TransformManager
         InterfaceTransform = new InterfaceTransform(namingRules, FunctionTransform, FunctionTransform, NamespaceRegistry, interopSignatureTransform, ioc);
     }
 
+    /// <summary>
+    /// Gets or sets the maximum number of elements transformed concurrently.
+    /// </summary>
+    /// <value>
+    /// <c>1</c> to transform sequentially, <c>0</c> to use as many workers as there are processors.
+    /// </value>
+    /// <remarks>
+    /// Only the transforms of independent elements, enums and functions, are parallelized.
+    /// Structs and interfaces depend on each other (nested layouts, base interfaces) and are always transformed in order.
+    /// </remarks>
+    public int MaxDegreeOfParallelism { get; set; } = 1;
+
     /// <summary>
     /// Gets the naming rules manager.
     /// </summary>
@@ -110,7 +124,8 @@ public sealed class TransformManager
                 configFile.Id
             );
 
-            ProcessCppModuleWithConfig(cppModule, configFile);
+            using (PhaseTrace.Begin($"Apply mapping rules [{configFile.Id}]"))
+                ProcessCppModuleWithConfig(cppModule, configFile);
             indexFile++;
         }
 
@@ -495,20 +510,27 @@ public sealed class TransformManager
         var selectedCSharpType = new List<CsBase>();
 
         // Prepare transform by defining/registering all types to process
-        selectedCSharpType.AddRange(PrepareTransform(moduleToTransform, EnumTransform));
-        selectedCSharpType.AddRange(PrepareTransform(moduleToTransform, StructTransform));
-        selectedCSharpType.AddRange(PrepareTransform(moduleToTransform, InterfaceTransform));
-        selectedCSharpType.AddRange(PrepareTransform<CppFunction, CsFunction>(moduleToTransform, FunctionTransform));
+        using (PhaseTrace.Begin("Prepare transform"))
+        {
+            selectedCSharpType.AddRange(PrepareTransform(moduleToTransform, EnumTransform));
+            selectedCSharpType.AddRange(PrepareTransform(moduleToTransform, StructTransform));
+            selectedCSharpType.AddRange(PrepareTransform(moduleToTransform, InterfaceTransform));
+            selectedCSharpType.AddRange(PrepareTransform<CppFunction, CsFunction>(moduleToTransform, FunctionTransform));
+        }
 
         // Transform all types
         Logger.Progress(65, "Transforming enums...");
-        ProcessTransform(EnumTransform, selectedCSharpType.OfType<CsEnum>());
+        using (PhaseTrace.Begin("Transform enums"))
+            ProcessTransformInParallel(EnumTransform, selectedCSharpType.OfType<CsEnum>());
         Logger.Progress(70, "Transforming structs...");
-        ProcessTransform(StructTransform, selectedCSharpType.OfType<CsStruct>());
+        using (PhaseTrace.Begin("Transform structs"))
+            ProcessTransform(StructTransform, selectedCSharpType.OfType<CsStruct>());
         Logger.Progress(75, "Transforming interfaces...");
-        ProcessTransform(InterfaceTransform, selectedCSharpType.OfType<CsInterface>());
+        using (PhaseTrace.Begin("Transform interfaces"))
+            ProcessTransform(InterfaceTransform, selectedCSharpType.OfType<CsInterface>());
         Logger.Progress(80, "Transforming functions...");
-        ProcessTransform(FunctionTransform, selectedCSharpType.OfType<CsFunction>());
+        using (PhaseTrace.Begin("Transform functions"))
+            ProcessTransformInParallel(FunctionTransform, selectedCSharpType.OfType<CsFunction>());
 
         CsAssembly asm = new();
 
@@ -578,6 +600,45 @@ public sealed class TransformManager
         }
     }
 
+    /// <summary>
+    /// Processes a transformer from C++ to C# model, on independent elements.
+    /// </summary>
+    /// <remarks>
+    /// The elements are only mutated by their own transform and are already attached to their container,
+    /// so the output doesn't depend on the order they are processed in.
+    /// </remarks>
+    /// <typeparam name="T">The C++ type of data to process</typeparam>
+    /// <param name="transform">The transform.</param>
+    /// <param name="typeToProcess">The type to process.</param>
+    private void ProcessTransformInParallel<T>(ITransformer<T> transform, IEnumerable<T> typeToProcess)
+        where T : CsBase
+    {
+        if (MaxDegreeOfParallelism == 1)
+        {
+            ProcessTransform(transform, typeToProcess);
+            return;
+        }
+
+        try
+        {
+            Parallel.ForEach(
+                typeToProcess.ToList(),
+                new ParallelOptions
+                {
+                    MaxDegreeOfParallelism = MaxDegreeOfParallelism > 0
+                                                 ? MaxDegreeOfParallelism
+                                                 : Environment.ProcessorCount
+                },
+                csItem => ProcessTransform(transform, new[] { csItem })
+            );
+        }
+        catch (AggregateException e)
+        {
+            // Rethrows the exception of a fatal error as is, the logger callers expect its own exception type
+            ExceptionDispatchInfo.Capture(e.Flatten().InnerExceptions[0]).Throw();
+        }
+    }
+
     /// <summary>
     /// Creates the C# class container used to group together loose elements (i.e. functions, constants).
     /// </summary>
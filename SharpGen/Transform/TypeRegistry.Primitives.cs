@@ -85,6 +85,9 @@ public partial class TypeRegistry
         typeof(nuint), new PrimitiveTypeIdentity(PrimitiveTypeCode.NUint), "nuint"
     );
 
+    // Guards the primitive type tables, pointer types are added to them on first use
+    private static readonly object PrimitiveTypesLock = new();
+
     private static readonly Dictionary<PrimitiveTypeIdentity, CsFundamentalType> PrimitiveTypeEntriesByIdentity =
         new()
         {
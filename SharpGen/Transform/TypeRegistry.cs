@@ -11,6 +11,7 @@ public sealed partial class TypeRegistry
 {
     private readonly Dictionary<string, BoundType> _mapCppNameToCSharpType = new();
     private readonly Dictionary<string, CsTypeBase> _mapDefinedCSharpType = new();
+    private readonly object syncRoot = new();
     private readonly Ioc ioc;
 
     private Logger Logger => ioc.Logger;
@@ -29,8 +30,17 @@ public sealed partial class TypeRegistry
 
     private void DefineTypeImpl(CsTypeBase type, string typeName)
     {
-        if (!_mapDefinedCSharpType.ContainsKey(typeName))
-            _mapDefinedCSharpType.Add(typeName, type);
+        lock (syncRoot)
+        {
+            if (!_mapDefinedCSharpType.ContainsKey(typeName))
+                _mapDefinedCSharpType.Add(typeName, type);
+        }
+    }
+
+    private bool TryGetDefinedType(string typeName, out CsTypeBase type)
+    {
+        lock (syncRoot)
+            return _mapDefinedCSharpType.TryGetValue(typeName, out type);
     }
 
     /// <summary>
@@ -44,7 +54,7 @@ public sealed partial class TypeRegistry
         if (primitiveType != null)
             return primitiveType;
 
-        if (_mapDefinedCSharpType.TryGetValue(typeName, out var cSharpType))
+        if (TryGetDefinedType(typeName, out var cSharpType))
             return cSharpType;
 
         var type = Type.GetType(typeName);
@@ -75,15 +85,24 @@ public sealed partial class TypeRegistry
             return new CsUndefinedType(null);
         }
 
-        if (_mapDefinedCSharpType.TryGetValue(typeName, out var cSharpType))
-            return cSharpType;
+        lock (syncRoot)
+        {
+            if (_mapDefinedCSharpType.TryGetValue(typeName, out var cSharpType))
+                return cSharpType;
 
-        cSharpType = new CsFundamentalType(type, typeName);
-        DefineTypeImpl(cSharpType, typeName);
-        return cSharpType;
+            cSharpType = new CsFundamentalType(type, typeName);
+            _mapDefinedCSharpType.Add(typeName, cSharpType);
+            return cSharpType;
+        }
     }
 
     public static CsFundamentalType ImportPrimitiveType(string typeName)
+    {
+        lock (PrimitiveTypesLock)
+            return ImportPrimitiveTypeImpl(typeName);
+    }
+
+    private static CsFundamentalType ImportPrimitiveTypeImpl(string typeName)
     {
         if (typeName == null)
             return null;
@@ -145,15 +164,18 @@ public sealed partial class TypeRegistry
         if (pointerCount == 1 && code == PrimitiveTypeCode.Void)
             return VoidPtr;
 
-        PrimitiveTypeIdentity baseIdentity = new(code);
-        var baseEntry = PrimitiveTypeEntriesByIdentity[baseIdentity];
+        lock (PrimitiveTypesLock)
+        {
+            PrimitiveTypeIdentity baseIdentity = new(code);
+            var baseEntry = PrimitiveTypeEntriesByIdentity[baseIdentity];
 
-        if (pointerCount == 0)
-            return baseEntry;
+            if (pointerCount == 0)
+                return baseEntry;
 
-        PrimitiveTypeIdentity identity = new(code, pointerCount);
+            PrimitiveTypeIdentity identity = new(code, pointerCount);
 
-        return FindPrimitiveTypeImpl(identity, baseEntry.QualifiedName, null);
+            return FindPrimitiveTypeImpl(identity, baseEntry.QualifiedName, null);
+        }
     }
 
     private static CsFundamentalType FindPrimitiveTypeImpl(PrimitiveTypeIdentity identity,
@@ -196,6 +218,12 @@ public sealed partial class TypeRegistry
         if (string.IsNullOrWhiteSpace(source))
             source = null;
 
+        lock (syncRoot)
+            BindTypeImpl(cppName, type, marshalType, source, @override);
+    }
+
+    private void BindTypeImpl(string cppName, CsTypeBase type, CsTypeBase marshalType, string source, bool @override)
+    {
         if (_mapCppNameToCSharpType.TryGetValue(cppName, out var old))
         {
             var match = type == old.CSharpType && marshalType == old.MarshalType;
@@ -250,7 +278,10 @@ public sealed partial class TypeRegistry
     public bool FindBoundType(string cppName, out BoundType boundType)
     {
         if (cppName != null)
-            return _mapCppNameToCSharpType.TryGetValue(cppName, out boundType);
+        {
+            lock (syncRoot)
+                return _mapCppNameToCSharpType.TryGetValue(cppName, out boundType);
+        }
 
         boundType = null;
         return false;
@@ -260,7 +291,12 @@ public sealed partial class TypeRegistry
     {
         List<BindRule> bindRules = new();
         List<DefineExtensionRule> defineRules = new();
-        foreach (var entry in _mapCppNameToCSharpType)
+
+        KeyValuePair<string, BoundType>[] bindings;
+        lock (syncRoot)
+            bindings = _mapCppNameToCSharpType.ToArray();
+
+        foreach (var entry in bindings)
         {
             var boundType = entry.Value;
             var csType = boundType.CSharpType;
@@ -14,263 +14,378 @@ using SharpGen.Platform.Documentation;
 
 namespace SharpGenTools.Sdk.Documentation;
 
+/// <summary>
+/// Documents the elements of a module, from the cache first and then from a documentation provider.
+/// </summary>
+/// <remarks>
+/// Identical names are queried once, and at most <c>maxParallelism</c> queries run at the same time.
+/// Providers implementing <see cref="IDocBatchProvider"/> are queried with batches of names.
+/// </remarks>
 internal static class DocProviderExecutor
 {
     private static readonly TimeSpan TenthOfSecond = TimeSpan.FromMilliseconds(100);
 
     public static async Task ApplyDocumentation(IDocProvider? docProvider, DocItemCache cache, CsAssembly module,
-                                                DocumentationContext context)
+                                                DocumentationContext context, int maxParallelism)
     {
-        var documentationTasks = new List<Task>();
+        List<string> queries = new();
+        Dictionary<string, List<DocumentationRequest>> pendingRequests =
+            new(StringComparer.InvariantCultureIgnoreCase);
 
-        Task DocumentSelector(CsBase cppElement) =>
-            DocumentElement(docProvider, cache, cppElement, context, true, null);
-
-        foreach (var cppInclude in module.Namespaces)
+        foreach (var request in CollectRequests(module))
         {
-            documentationTasks.AddRange(cppInclude.Enums.Select(DocumentSelector));
-            documentationTasks.AddRange(cppInclude.Structs.Select(DocumentSelector));
-            documentationTasks.AddRange(
-                cppInclude.Interfaces
-                          .Select(cppInterface => DocumentInterface(docProvider, cache, cppInterface, context))
-            );
-            documentationTasks.AddRange(
-                cppInclude.Classes
-                          .Select(cppFunction => DocumentGroup(docProvider, cache, cppFunction, context))
-            );
+            if (string.IsNullOrEmpty(request.Name))
+                continue;
+
+            var cacheEntry = cache.Find(request.Name);
+            if (cacheEntry != null)
+            {
+                ApplyDocItem(request, cacheEntry);
+                continue;
+            }
+
+            if (docProvider == null)
+                continue;
+
+            if (!pendingRequests.TryGetValue(request.Name, out var requests))
+            {
+                pendingRequests.Add(request.Name, requests = new List<DocumentationRequest>());
+                queries.Add(request.Name);
+            }
+
+            requests.Add(request);
         }
 
-        await Task.WhenAll(documentationTasks);
+        if (docProvider == null || queries.Count == 0)
+            return;
+
+        var results = await QueryDocumentationProvider(docProvider, queries, context, maxParallelism);
+
+        for (var i = 0; i < queries.Count; i++)
+        {
+            var docItem = results[i];
+            if (docItem == null)
+                continue;
+
+            foreach (var request in pendingRequests[queries[i]])
+                ApplyDocItem(request, docItem);
+
+            cache.Add(docItem);
+        }
     }
 
-    private static async Task<IDocItem?> DocumentElement(IDocProvider? docProvider,
-                                                         DocItemCache cache,
-                                                         CsBase element,
-                                                         DocumentationContext context,
-                                                         bool documentInnerElements,
-                                                         string? name)
+    /// <summary>
+    /// Lists the documented elements of the module with their documentation names.
+    /// </summary>
+    private static IEnumerable<DocumentationRequest> CollectRequests(CsAssembly module)
     {
-        var docName = name ?? element.CppElementName;
+        foreach (var cppInclude in module.Namespaces)
+        {
+            foreach (var cppEnum in cppInclude.Enums)
+                yield return new DocumentationRequest(cppEnum, null, true);
 
-        if (string.IsNullOrEmpty(docName))
-            return null;
+            foreach (var cppStruct in cppInclude.Structs)
+                yield return new DocumentationRequest(cppStruct, null, true);
 
-        docName = docName.Trim();
+            foreach (var cppInterface in cppInclude.Interfaces)
+            {
+                // TODO: fix properties docs (they extract doc data from methods on attach to interface)
+                foreach (var method in cppInterface.Methods)
+                    yield return new DocumentationRequest(
+                        method, cppInterface.CppElementName + "::" + method.Name, true
+                    );
 
-        if (string.IsNullOrEmpty(docName))
-            return null;
+                foreach (var constant in cppInterface.Items.OfType<CsConstantBase>())
+                    yield return new DocumentationRequest(constant, null, true);
 
-        var cacheEntry = cache.Find(docName);
-        var docItem = cacheEntry ?? await QueryDocumentationProvider();
+                yield return new DocumentationRequest(cppInterface, null, false);
+            }
 
-        if (docItem == null)
-            return null;
+            foreach (var cppGroup in cppInclude.Classes)
+            {
+                foreach (var function in cppGroup.Functions)
+                    yield return new DocumentationRequest(function, null, true);
+
+                foreach (var constant in cppGroup.Items.OfType<CsConstantBase>())
+                    yield return new DocumentationRequest(constant, null, true);
+
+                yield return new DocumentationRequest(cppGroup, null, false);
+            }
+        }
+    }
+
+    private static void ApplyDocItem(DocumentationRequest request, IDocItem docItem)
+    {
+        var element = request.Element;
 
         element.DocId = docItem.ShortId;
         element.Description = docItem.Summary;
         element.Remarks = docItem.Remarks;
-        docItem.Names.Add(docName);
+        docItem.Names.Add(request.Name);
 
-        if (cacheEntry == null)
-            cache.Add(docItem);
+        if (request.DocumentInnerElements && element.Items.Count != 0)
+            DocumentInnerElements(element.Items, docItem);
 
-        if (element.Items.Count == 0)
-            return docItem;
+        if (element is CsCallable callable)
+            callable.ReturnValue.Description = docItem.Return;
+    }
 
-        if (documentInnerElements)
-            DocumentInnerElements(element.Items, docItem);
+    private static async Task<IDocItem?[]> QueryDocumentationProvider(IDocProvider docProvider,
+                                                                      IReadOnlyList<string> queries,
+                                                                      DocumentationContext context,
+                                                                      int maxParallelism)
+    {
+        var results = new IDocItem?[queries.Count];
+        Lazy<string> providerName = new(() => GetProviderName(docProvider));
 
-        return docItem;
+        var batchSize = docProvider is IDocBatchProvider batchProvider ? GetMaxBatchSize(batchProvider) : 1;
 
-        async Task<IDocItem?> QueryDocumentationProvider()
+        if (batchSize > 1)
         {
-            if (docProvider == null)
-                return null;
+            var batchCount = (queries.Count + batchSize - 1) / batchSize;
 
-            Lazy<string> docProviderName = new(
-                () =>
+            await RunBounded(
+                batchCount, maxParallelism,
+                async batch =>
                 {
-                    try
-                    {
-                        var friendlyName = docProvider.UserFriendlyName;
-                        return string.IsNullOrWhiteSpace(friendlyName) ? FullName() : friendlyName;
-                    }
-                    catch
-                    {
-                        return FullName();
-                    }
+                    var offset = batch * batchSize;
+                    var names = queries.Skip(offset).Take(batchSize).ToArray();
+                    var batchResults = await QueryBatch((IDocBatchProvider) docProvider, names, context, providerName);
 
-                    string FullName()
+                    for (var i = 0; i < names.Length; i++)
                     {
-                        var type = docProvider.GetType();
-                        var name = type.FullName;
-                        return string.IsNullOrEmpty(name) ? type.Name : name!;
+                        results[offset + i] = batchResults?[i] is { } result
+                                                  ? result.Item
+                                                  : await QuerySingle(docProvider, names[i], context, providerName);
                     }
-                },
-                LazyThreadSafetyMode.None
+                }
+            );
+        }
+        else
+        {
+            await RunBounded(
+                queries.Count, maxParallelism,
+                async i => results[i] = await QuerySingle(docProvider, queries[i], context, providerName)
+            );
+        }
+
+        return results;
+    }
+
+    /// <summary>
+    /// Runs <paramref name="count"/> work items, at most <paramref name="maxParallelism"/> at the same time.
+    /// </summary>
+    private static Task RunBounded(int count, int maxParallelism, Func<int, Task> body)
+    {
+        var next = -1;
+        var workerCount = Math.Min(count, maxParallelism > 0 ? maxParallelism : Environment.ProcessorCount);
+
+        async Task Worker()
+        {
+            int index;
+            while ((index = Interlocked.Increment(ref next)) < count)
+                await body(index);
+        }
+
+        return Task.WhenAll(Enumerable.Range(0, workerCount).Select(_ => Worker()));
+    }
+
+    private static int GetMaxBatchSize(IDocBatchProvider docProvider)
+    {
+        try
+        {
+            return docProvider.MaxBatchSize;
+        }
+        catch
+        {
+            return 1;
+        }
+    }
+
+    /// <summary>
+    /// Queries a batch of names, the names without a final result are <c>null</c> in the returned array.
+    /// </summary>
+    /// <returns>The results of the batch, or <c>null</c> when the batch query failed as a whole.</returns>
+    private static async Task<BatchResult?[]?> QueryBatch(IDocBatchProvider docProvider, string[] names,
+                                                          DocumentationContext context, Lazy<string> providerName)
+    {
+        IReadOnlyList<IFindDocumentationResult> results;
+
+        try
+        {
+            results = await docProvider.FindDocumentationAsync(names, context);
+        }
+        catch (Exception e)
+        {
+            context.Logger.Message(
+                $"{providerName.Value} extension failed to find documentation for a batch of {names.Length} names, " +
+                $"querying them one by one: {e.Message}"
+            );
+            return null;
+        }
+
+        if (results == null || results.Count != names.Length)
+        {
+            context.Logger.Message(
+                $"{providerName.Value} extension returned {results?.Count ?? 0} results for a batch of {names.Length} names, " +
+                "querying them one by one"
             );
+            return null;
+        }
+
+        var batchResults = new BatchResult?[names.Length];
+        for (var i = 0; i < names.Length; i++)
+        {
+            batchResults[i] = results[i] switch
+            {
+                FindDocumentationResultSuccess success => new BatchResult(success.Item),
+                FindDocumentationResultFailure { RetryDelay: var delay } when delay == TimeSpan.MaxValue =>
+                    new BatchResult(null),
+                _ => null
+            };
+        }
 
-            List<Exception> exceptions = new(3);
-            var (backoff, backoffIndex, nextDelay) = GenerateBackoff(TimeSpan.Zero);
+        return batchResults;
+    }
+
+    private static async Task<IDocItem?> QuerySingle(IDocProvider docProvider, string docName,
+                                                     DocumentationContext context, Lazy<string> providerName)
+    {
+        List<Exception> exceptions = new(3);
+        var (backoff, backoffIndex, nextDelay) = GenerateBackoff(TimeSpan.Zero);
 
-            try
+        try
+        {
+            for (uint retry = 0; retry <= 5; retry++)
             {
-                for (uint retry = 0; retry <= 5; retry++)
+                if (retry != 0)
                 {
-                    if (retry != 0)
+                    TimeSpan delay;
+                    if (nextDelay.HasValue)
+                        delay = nextDelay.Value;
+                    else
                     {
-                        TimeSpan delay;
-                        if (nextDelay.HasValue)
-                            delay = nextDelay.Value;
-                        else
+                        // TODO: fix the bug and remove this hack
+                        if (backoffIndex >= 5)
                         {
-                            // TODO: fix the bug and remove this hack
-                            if (backoffIndex >= 5)
-                            {
-                                context.Logger.Message(
-                                    $"SharpGen internal invalid state on delay: backoffIndex == {backoffIndex}"
-                                );
-                                if (Debugger.IsAttached) Debugger.Break();
-                                backoffIndex = 0;
-                            }
-
-                            delay = backoff[backoffIndex++];
+                            context.Logger.Message(
+                                $"SharpGen internal invalid state on delay: backoffIndex == {backoffIndex}"
+                            );
+                            if (Debugger.IsAttached) Debugger.Break();
+                            backoffIndex = 0;
                         }
-                        if (delay > TimeSpan.Zero)
-                            await Task.Delay(delay);
-                        nextDelay = null;
+
+                        delay = backoff[backoffIndex++];
                     }
+                    if (delay > TimeSpan.Zero)
+                        await Task.Delay(delay);
+                    nextDelay = null;
+                }
 
-                    try
+                try
+                {
+                    var result = await docProvider.FindDocumentationAsync(docName, context);
+                    switch (result)
                     {
-                        var result = await docProvider.FindDocumentationAsync(docName, context);
-                        switch (result)
+                        case null:
+                            throw new ArgumentNullException(
+                                nameof(result),
+                                $"Unexpected null {nameof(IFindDocumentationResult)}"
+                            );
+                        case FindDocumentationResultFailure resultFailure:
                         {
-                            case null:
-                                throw new ArgumentNullException(
-                                    nameof(result),
-                                    $"Unexpected null {nameof(IFindDocumentationResult)}"
-                                );
-                            case FindDocumentationResultFailure resultFailure:
-                            {
-                                var retryDelay = resultFailure.RetryDelay;
-                                if (retryDelay == TimeSpan.MaxValue)
-                                    return null;
+                            var retryDelay = resultFailure.RetryDelay;
+                            if (retryDelay == TimeSpan.MaxValue)
+                                return null;
 
-                                if (retryDelay <= TimeSpan.Zero)
-                                    nextDelay = TimeSpan.Zero;
+                            if (retryDelay <= TimeSpan.Zero)
+                                nextDelay = TimeSpan.Zero;
 
-                                // TODO: fix the bug and remove this hack
-                                if (backoffIndex >= 5)
-                                {
-                                    context.Logger.Message(
-                                        $"SharpGen internal invalid state on reschedule: backoffIndex = {backoffIndex}"
-                                    );
-                                    if (Debugger.IsAttached) Debugger.Break();
-                                    (backoff, backoffIndex, nextDelay) = GenerateBackoff(retryDelay);
-                                }
+                            // TODO: fix the bug and remove this hack
+                            if (backoffIndex >= 5)
+                            {
+                                context.Logger.Message(
+                                    $"SharpGen internal invalid state on reschedule: backoffIndex = {backoffIndex}"
+                                );
+                                if (Debugger.IsAttached) Debugger.Break();
+                                (backoff, backoffIndex, nextDelay) = GenerateBackoff(retryDelay);
+                            }
 
-                                nextDelay = backoff[backoffIndex++];
+                            nextDelay = backoff[backoffIndex++];
 
-                                if (nextDelay < retryDelay)
-                                    (backoff, backoffIndex, nextDelay) = GenerateBackoff(retryDelay);
+                            if (nextDelay < retryDelay)
+                                (backoff, backoffIndex, nextDelay) = GenerateBackoff(retryDelay);
 
-                                break;
-                            }
-                            case FindDocumentationResultSuccess resultSuccess:
-                                return resultSuccess.Item; // TODO: check if the item is empty (therefore, useless)
-                            default:
-                                throw new ArgumentOutOfRangeException(
-                                    nameof(result),
-                                    $"Unexpected {nameof(IFindDocumentationResult)}: {result.GetType().FullName}"
-                                );
+                            break;
                         }
-                    }
-                    catch (Exception e)
-                    {
-                        e.Data["SDK:" + nameof(docProvider)] = docProvider;
-                        e.Data["SDK:" + nameof(docName)] = docName;
-                        e.Data["SDK:" + nameof(context)] = context;
-                        e.Data["SDK:" + nameof(retry)] = retry;
-                        e.Data["SDK:" + nameof(backoffIndex)] = backoffIndex;
-                        e.Data["SDK:" + nameof(exceptions) + ".Count"] = exceptions.Count;
-
-                        exceptions.Add(e);
-
-                        // We should retry less when it's due to unhandled exception.
-                        // So in exception case we step twice in retry count on each iteration.
-                        retry++;
+                        case FindDocumentationResultSuccess resultSuccess:
+                            return resultSuccess.Item; // TODO: check if the item is empty (therefore, useless)
+                        default:
+                            throw new ArgumentOutOfRangeException(
+                                nameof(result),
+                                $"Unexpected {nameof(IFindDocumentationResult)}: {result.GetType().FullName}"
+                            );
                     }
                 }
+                catch (Exception e)
+                {
+                    e.Data["SDK:" + nameof(docProvider)] = docProvider;
+                    e.Data["SDK:" + nameof(docName)] = docName;
+                    e.Data["SDK:" + nameof(context)] = context;
+                    e.Data["SDK:" + nameof(retry)] = retry;
+                    e.Data["SDK:" + nameof(backoffIndex)] = backoffIndex;
+                    e.Data["SDK:" + nameof(exceptions) + ".Count"] = exceptions.Count;
+
+                    exceptions.Add(e);
+
+                    // We should retry less when it's due to unhandled exception.
+                    // So in exception case we step twice in retry count on each iteration.
+                    retry++;
+                }
+            }
 
-                context.Logger.Message($"{docProviderName.Value} extension failed to find documentation for \"{docName}\"");
+            context.Logger.Message($"{providerName.Value} extension failed to find documentation for \"{docName}\"");
 
-                return null;
-            }
-            finally
+            return null;
+        }
+        finally
+        {
+            if (exceptions.Count > 0)
             {
-                if (exceptions.Count > 0)
+                var failure = new DocumentationQueryFailure(docName)
                 {
-                    var failure = new DocumentationQueryFailure(docName)
-                    {
-                        Exceptions = exceptions,
-                        FailedProviderName = docProviderName.Value,
-                        TreatProviderFailuresAsErrors = docProvider.TreatFailuresAsErrors
-                    };
+                    Exceptions = exceptions,
+                    FailedProviderName = providerName.Value,
+                    TreatProviderFailuresAsErrors = docProvider.TreatFailuresAsErrors
+                };
 
-                    context.Failures.Add(failure);
-                }
+                context.Failures.Add(failure);
             }
         }
     }
 
-    private static (TimeSpan[] backoff, int index, TimeSpan? nextDelay) GenerateBackoff(TimeSpan offset) =>
-        (Backoff.DecorrelatedJitterBackoffV2(offset + TenthOfSecond, 5).ToArray(), 0, null);
-
-    private static async Task DocumentCallable(IDocProvider? docProvider, DocItemCache cache,
-                                               CsCallable callable, DocumentationContext context,
-                                               string? name = null)
+    private static string GetProviderName(IDocProvider docProvider)
     {
-        var docItem = await DocumentElement(docProvider, cache, callable, context, true, name);
-
-        if (docItem == null)
-            return;
-
-        callable.ReturnValue.Description = docItem.Return;
-    }
+        try
+        {
+            var friendlyName = docProvider.UserFriendlyName;
+            return string.IsNullOrWhiteSpace(friendlyName) ? FullName() : friendlyName;
+        }
+        catch
+        {
+            return FullName();
+        }
 
-    private static async Task DocumentInterface(IDocProvider? docProvider, DocItemCache cache,
-                                                CsInterface cppInterface, DocumentationContext context)
-    {
-        Task CallableSelector(CsCallable func) =>
-            DocumentCallable(docProvider, cache, func, context, cppInterface.CppElementName + "::" + func.Name);
-
-        Task VariableSelector(CsBase cppElement) =>
-            DocumentElement(docProvider, cache, cppElement, context, true, null);
-
-        // TODO: fix properties docs (they extract doc data from methods on attach to interface)
-        await Task.WhenAll(
-            cppInterface.Methods.Select(CallableSelector)
-                        .Concat(cppInterface.Items.OfType<CsConstantBase>().Select(VariableSelector))
-                        .Append(DocumentElement(docProvider, cache, cppInterface, context, false, null))
-        );
+        string FullName()
+        {
+            var type = docProvider.GetType();
+            var name = type.FullName;
+            return string.IsNullOrEmpty(name) ? type.Name : name!;
+        }
     }
 
-    private static async Task DocumentGroup(IDocProvider? docProvider, DocItemCache cache,
-                                            CsGroup cppInterface, DocumentationContext context)
-    {
-        Task CallableSelector(CsCallable func) =>
-            DocumentCallable(docProvider, cache, func, context);
-
-        Task VariableSelector(CsBase cppElement) =>
-            DocumentElement(docProvider, cache, cppElement, context, true, null);
-
-        await Task.WhenAll(
-            cppInterface.Functions.Select(CallableSelector)
-                        .Concat(cppInterface.Items.OfType<CsConstantBase>().Select(VariableSelector))
-                        .Append(DocumentElement(docProvider, cache, cppInterface, context, false, null))
-        );
-    }
+    private static (TimeSpan[] backoff, int index, TimeSpan? nextDelay) GenerateBackoff(TimeSpan offset) =>
+        (Backoff.DecorrelatedJitterBackoffV2(offset + TenthOfSecond, 5).ToArray(), 0, null);
 
     private static void DocumentInnerElements(IReadOnlyCollection<CsBase> elements, IDocItem docItem)
     {
@@ -311,4 +426,25 @@ internal static class DocProviderExecutor
 
         return Regex.IsMatch(str, $@"\b{Regex.Escape(identifier)}\b", RegexOptions.CultureInvariant | RegexOptions.IgnoreCase);
     }
+
+    private readonly struct DocumentationRequest
+    {
+        public DocumentationRequest(CsBase element, string? name, bool documentInnerElements)
+        {
+            Element = element;
+            Name = (name ?? element.CppElementName)?.Trim();
+            DocumentInnerElements = documentInnerElements;
+        }
+
+        public CsBase Element { get; }
+        public string? Name { get; }
+        public bool DocumentInnerElements { get; }
+    }
+
+    private readonly struct BatchResult
+    {
+        public BatchResult(IDocItem? item) => Item = item;
+
+        public IDocItem? Item { get; }
+    }
 }
\ No newline at end of file
@@ -86,7 +86,8 @@ internal sealed class ExtensibilityDriver
         docProviders = docProviderBuilder.ToImmutable();
     }
 
-    public async Task DocumentModule(LoggerBase logger, DocItemCache cache, CsAssembly module, Lazy<DocumentationContext> context)
+    public async Task DocumentModule(LoggerBase logger, DocItemCache cache, CsAssembly module,
+                                     Lazy<DocumentationContext> context, int maxParallelism)
     {
         ResolveExtensibilityPoints(logger, out var documentationProviders);
 
@@ -98,7 +99,9 @@ internal sealed class ExtensibilityDriver
         foreach (var documentationProvider in documentationProviders)
         {
             // Wait on every provider (sequential execution to prevent data races)
-            await DocProviderExecutor.ApplyDocumentation(documentationProvider, cache, module, docContext);
+            await DocProviderExecutor.ApplyDocumentation(
+                documentationProvider, cache, module, docContext, maxParallelism
+            );
         }
     }
 
@@ -64,10 +64,9 @@ public ref struct CacheFile
     private bool ComputeIsWriteNeeded()
     {
         Debug.Assert(_isWriteNeeded is null);
-        Debug.Assert(_writer is not null);
         Debug.Assert(!_hasWritten);
 
-        _writer.Dispose();
+        _writer?.Dispose();
 
         File.Refresh();
 
@@ -98,6 +97,14 @@ public ref struct CacheFile
             ? _writer = new StreamWriter(Stream, SharpGenTask.DefaultEncoding, 1024, true)
             : throw new InvalidOperationException();
 
+    /// <summary>
+    /// Gets the stream receiving the new contents, for serializers handling the encoding on their own.
+    /// </summary>
+    public Stream OutputStream =>
+        _writer is null
+            ? Stream
+            : throw new InvalidOperationException();
+
     public void Write()
     {
         Debug.Assert(_isWriteNeeded == true);
@@ -0,0 +1,79 @@
+#nullable enable
+
+using System;
+using System.Collections.Concurrent;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using SharpGen.Config;
+using SharpGen.Logging;
+using SharpGen.Parser;
+
+namespace SharpGenTools.Sdk.Internal;
+
+/// <summary>
+/// State reused by all the task executions of a process.
+/// </summary>
+/// <remarks>
+/// MSBuild keeps its worker nodes alive for all the projects of a build, and across builds with node reuse.
+/// Lookups whose results only depend on the machine are done once per node, like the compiler server
+/// keeps its state across compilations.
+/// </remarks>
+internal static class ProcessStateCache
+{
+    private static readonly ConcurrentDictionary<string, string[]> SdkIncludeDirs = new(StringComparer.Ordinal);
+    private static readonly ConcurrentDictionary<string, (long Size, long LastWriteTime, IReadOnlyList<string> CommentIds)> ExternalDocCommentIds =
+        new(StringComparer.OrdinalIgnoreCase);
+
+    /// <summary>
+    /// Resolves the include directories of an SDK, reusing the result of a previous resolution in this process.
+    /// </summary>
+    /// <remarks>
+    /// Only successful resolutions are reused, the environment variables overriding the SDK locations
+    /// are part of the cache key.
+    /// </remarks>
+    public static IEnumerable<IncludeDirRule> ResolveIncludeDirsForSdk(SdkResolver resolver, SdkRule sdk, Logger logger)
+    {
+        var key = string.Join(
+            "|",
+            sdk._Name_, sdk.Version, sdk.Components,
+            Environment.GetEnvironmentVariable("SHARPGEN_VS_OVERRIDE"),
+            Environment.GetEnvironmentVariable("SHARPGEN_SDK_OVERRIDE")
+        );
+
+        if (SdkIncludeDirs.TryGetValue(key, out var paths))
+        {
+            logger.Message("Reusing the include directories resolved by a previous build");
+        }
+        else
+        {
+            var hadErrors = logger.HasErrors;
+
+            paths = resolver.ResolveIncludeDirsForSdk(sdk).Select(static x => x.Path).ToArray();
+
+            if (!hadErrors && !logger.HasErrors)
+                SdkIncludeDirs.TryAdd(key, paths);
+        }
+
+        return paths.Select(static x => new IncludeDirRule(x));
+    }
+
+    /// <summary>
+    /// Loads the comment ids of an external documentation file, reusing the ids loaded by a previous build
+    /// when the file is unchanged.
+    /// </summary>
+    public static IReadOnlyList<string> LoadExternalDocCommentIds(string path, Func<string, IReadOnlyList<string>> load)
+    {
+        FileInfo file = new(path);
+        long size = file.Length, lastWriteTime = file.LastWriteTimeUtc.Ticks;
+
+        if (ExternalDocCommentIds.TryGetValue(path, out var entry) && entry.Size == size &&
+            entry.LastWriteTime == lastWriteTime)
+            return entry.CommentIds;
+
+        var commentIds = load(path);
+
+        ExternalDocCommentIds[path] = (size, lastWriteTime, commentIds);
+        return commentIds;
+    }
+}
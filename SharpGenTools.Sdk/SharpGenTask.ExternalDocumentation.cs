@@ -0,0 +1,132 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Threading.Tasks;
+using SharpGen.Platform;
+using SharpGen.Transform;
+using SharpGenTools.Sdk.Internal;
+
+namespace SharpGenTools.Sdk;
+
+public sealed partial class SharpGenTask
+{
+    private const string ExternalDocumentationIndexExtension = ".ids";
+    private static readonly char[] NewLineChars = { '\r', '\n' };
+
+    private string ExternalDocumentationIndexDirectory => GetProfileChild("ExternalDocumentation");
+
+    /// <summary>
+    /// Lists the comment ids of every external documentation file.
+    /// </summary>
+    /// <remarks>
+    /// The ids of a file are stored in the profile directory under the hash of its contents,
+    /// so unchanged files are only hashed by the next builds, not parsed again.
+    /// </remarks>
+    private (string File, IEnumerable<string> CommentIds)[] LoadExternalDocumentation()
+    {
+        var files = ExternalDocumentation!;
+        var indexFiles = new string?[files.Length];
+        var commentIds = new IReadOnlyList<string>[files.Length];
+
+        Parallel.For(
+            0, files.Length,
+            i => commentIds[i] = ReuseProcessState
+                                     ? ProcessStateCache.LoadExternalDocCommentIds(
+                                         files[i], file => LoadExternalDocCommentIds(file, out indexFiles[i])
+                                     )
+                                     : LoadExternalDocCommentIds(files[i], out indexFiles[i])
+        );
+
+        RemoveStaleExternalDocumentationIndexFiles(indexFiles);
+
+        return files.Select((file, i) => (file, (IEnumerable<string>) commentIds[i])).ToArray();
+    }
+
+    private IReadOnlyList<string> LoadExternalDocCommentIds(string file, out string? indexFile)
+    {
+        string hash;
+        using (var stream = File.OpenRead(file))
+            hash = FileHashCache.ComputeHash(stream);
+
+        // Base64 isn't usable as a file name on case-insensitive file systems
+        indexFile = Path.Combine(
+            ExternalDocumentationIndexDirectory,
+            BitConverter.ToString(Convert.FromBase64String(hash)).Replace("-", string.Empty) +
+            ExternalDocumentationIndexExtension
+        );
+
+        try
+        {
+            if (File.Exists(indexFile))
+                return File.ReadAllLines(indexFile, DefaultEncoding);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+        }
+
+        List<string> commentIds;
+        using (var stream = File.OpenRead(file))
+            commentIds = ExternalDocCommentsReader.ReadCommentIds(stream);
+
+        // Ids spanning several lines can't be stored, the file will be parsed again by the next builds
+        if (commentIds.Any(static x => x.IndexOfAny(NewLineChars) != -1))
+            return commentIds;
+
+        // Written aside and moved in place, so that a concurrent build never reads a partial index
+        var temporaryFile = indexFile + "." + Guid.NewGuid().ToString("N") + ".tmp";
+
+        try
+        {
+            Directory.CreateDirectory(ExternalDocumentationIndexDirectory);
+            File.WriteAllLines(temporaryFile, commentIds, DefaultEncoding);
+            File.Move(temporaryFile, indexFile);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            // Another build may have stored the same index in the meantime
+            if (!File.Exists(indexFile))
+                SharpGenLogger.Message("Unable to write the external documentation index {0}: {1}", indexFile, e.Message);
+
+            try
+            {
+                File.Delete(temporaryFile);
+            }
+            catch (Exception deleteException) when (deleteException is IOException or UnauthorizedAccessException)
+            {
+            }
+        }
+
+        return commentIds;
+    }
+
+    private void RemoveStaleExternalDocumentationIndexFiles(IEnumerable<string?> indexFiles)
+    {
+        if (!Directory.Exists(ExternalDocumentationIndexDirectory))
+            return;
+
+        // Files reused from the process state have no index file of this run, keep them all
+        if (indexFiles.Any(static x => x == null))
+            return;
+
+        HashSet<string> usedFiles = new(indexFiles!, StringComparer.OrdinalIgnoreCase);
+
+        foreach (var file in Directory.EnumerateFiles(
+                     ExternalDocumentationIndexDirectory, "*" + ExternalDocumentationIndexExtension
+                 ))
+        {
+            if (usedFiles.Contains(file))
+                continue;
+
+            try
+            {
+                File.Delete(file);
+            }
+            catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+            {
+            }
+        }
+    }
+}
@@ -2,13 +2,16 @@ using System;
 using System.Collections.Generic;
 using System.Diagnostics;
 using System.IO;
+using System.Threading.Tasks;
+using SharpGen.Platform;
 using SharpGenTools.Sdk.Internal;
 
 namespace SharpGenTools.Sdk;
 
 public sealed partial class SharpGenTask
 {
-    private const string InputsCacheMarkerFiles = "# Files";
+    private const string InputsCacheMarkerFiles = "# Files with content hashes";
+    private const string InputsCacheNoHash = "-";
     private const string InputsCacheMarkerEnvironmentVariables = "# Environment variables";
     private readonly List<string> inputsCacheListFiles = new();
     private readonly List<string> inputsCacheListEnvironmentVariables = new();
@@ -24,6 +27,12 @@ public sealed partial class SharpGenTask
     {
         inputsCacheImmutable = true;
 
+        var hashes = new string[inputsCacheListFiles.Count];
+        Parallel.For(
+            0, hashes.Length,
+            i => hashes[i] = ComputeInputsCacheFileHash(inputsCacheListFiles[i], inputsCacheMetadataFiles[i])
+        );
+
         using CacheFile cacheFile = new(new FileInfo(InputsCache));
 
         {
@@ -34,6 +43,8 @@ public sealed partial class SharpGenTask
             {
                 writer.Write(inputsCacheMetadataFiles[i]);
                 writer.Write(' ');
+                writer.Write(hashes[i]);
+                writer.Write(' ');
                 writer.WriteLine(inputsCacheListFiles[i]);
             }
 
@@ -65,7 +76,29 @@ public sealed partial class SharpGenTask
         FileInfo file = new(path);
         Debug.Assert(file.Exists);
 
-        return $"{file.CreationTimeUtc.Ticks} {file.LastWriteTimeUtc.Ticks} {file.Length}";
+        return ComputeInputsCacheFileMetadata(file);
+    }
+
+    private static string ComputeInputsCacheFileMetadata(FileInfo file) =>
+        $"{file.CreationTimeUtc.Ticks} {file.LastWriteTimeUtc.Ticks} {file.Length}";
+
+    private static string ComputeInputsCacheFileHash(string path, string metadata)
+    {
+        string hash;
+
+        try
+        {
+            using var stream = File.OpenRead(path);
+            hash = FileHashCache.ComputeHash(stream);
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            return InputsCacheNoHash;
+        }
+
+        // The file has changed since the generation read it, the hash doesn't describe the generation inputs
+        FileInfo file = new(path);
+        return file.Exists && ComputeInputsCacheFileMetadata(file) == metadata ? hash : InputsCacheNoHash;
     }
 
     private static string ComputeInputsCacheEnvironmentVariableMetadata(string name) =>
@@ -119,8 +152,13 @@ public sealed partial class SharpGenTask
 
         bool files = false, env = false;
 
-        foreach (var line in File.ReadLines(InputsCache, DefaultEncoding))
+        var lines = File.ReadAllLines(InputsCache, DefaultEncoding);
+        List<(int Line, string Path, string Metadata, long Size, string Hash)> fileEntries = new();
+
+        for (var lineIndex = 0; lineIndex < lines.Length; lineIndex++)
         {
+            var line = lines[lineIndex];
+
             if (string.IsNullOrWhiteSpace(line))
                 continue;
 
@@ -136,23 +174,11 @@ public sealed partial class SharpGenTask
             }
             else if (files)
             {
-                var items = line.Split(SpaceSeparator, 4);
-                long creation = long.Parse(items[0]),
-                     modified = long.Parse(items[1]),
-                     size = long.Parse(items[2]);
-                FileInfo file = new(items[3]);
-
-                if (!file.Exists)
+                var items = line.Split(SpaceSeparator, 5);
+                if (items.Length != 5)
                     return false;
 
-                if (file.Length != size)
-                    return false;
-
-                if (file.CreationTimeUtc.Ticks != creation)
-                    return false;
-
-                if (file.LastWriteTimeUtc.Ticks != modified)
-                    return false;
+                fileEntries.Add((lineIndex, items[4], $"{items[0]} {items[1]} {items[2]}", long.Parse(items[2]), items[3]));
             }
             else if (env)
             {
@@ -177,6 +203,77 @@ public sealed partial class SharpGenTask
             }
         }
 
+        // Files are checked by their stat data first, and only hashed when it differs
+        // (e.g. after a fresh checkout), so that the cache survives timestamp-only changes.
+        var refreshedMetadata = new string[fileEntries.Count];
+        var result = Parallel.For(
+            0, fileEntries.Count,
+            (i, state) =>
+            {
+                var (_, path, metadata, size, hash) = fileEntries[i];
+                FileInfo file = new(path);
+
+                if (!file.Exists || file.Length != size)
+                {
+                    state.Stop();
+                    return;
+                }
+
+                var currentMetadata = ComputeInputsCacheFileMetadata(file);
+                if (currentMetadata == metadata)
+                    return;
+
+                if (hash == InputsCacheNoHash || ComputeInputsCacheFileHash(path, currentMetadata) != hash)
+                {
+                    state.Stop();
+                    return;
+                }
+
+                refreshedMetadata[i] = currentMetadata;
+            }
+        );
+
+        if (!result.IsCompleted)
+            return false;
+
+        RefreshInputsCache(lines, fileEntries, refreshedMetadata);
+
         return true;
     }
+
+    private void RefreshInputsCache(string[] lines,
+                                    List<(int Line, string Path, string Metadata, long Size, string Hash)> fileEntries,
+                                    string[] refreshedMetadata)
+    {
+        var refreshedCount = 0;
+        for (var i = 0; i < fileEntries.Count; i++)
+        {
+            if (refreshedMetadata[i] is not { } metadata)
+                continue;
+
+            var (line, path, _, _, hash) = fileEntries[i];
+            lines[line] = $"{metadata} {hash} {path}";
+            refreshedCount++;
+        }
+
+        if (refreshedCount == 0)
+            return;
+
+        SharpGenLogger.Message(
+            "Input file cache is up-to-date, {0} files only have new timestamps.", refreshedCount
+        );
+
+        // Record the new timestamps, so that the next builds don't hash these files again
+        using CacheFile cacheFile = new(new FileInfo(InputsCache));
+
+        {
+            using var writer = cacheFile.StreamWriter;
+
+            foreach (var line in lines)
+                writer.WriteLine(line);
+        }
+
+        if (cacheFile.IsWriteNeeded)
+            cacheFile.Write();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,172 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using SharpGen.Config;
+using SharpGen.Parser;
+using SharpGen.Platform;
+
+namespace SharpGenTools.Sdk;
+
+public sealed partial class SharpGenTask
+{
+    private const string PrecompiledHeaderKeyMarker = "# Key ";
+
+    /// <summary>
+    /// Builds the precompiled header of the system includes starting the root config header,
+    /// unless the one built by a previous run is still up-to-date.
+    /// </summary>
+    /// <returns>The precompiled header, or <c>null</c> if there is none to use.</returns>
+    /// <remarks>
+    /// The precompiled header is up-to-date when the CastXML command line, the precompiled source
+    /// and the headers listed in its dependency file are unchanged.
+    /// </remarks>
+    private string? PreparePrecompiledHeader(ConfigFile config, CppHeaderGenerator cppHeaderGenerator,
+                                             IReadOnlyCollection<ConfigFile> configsWithHeaders,
+                                             ISet<ConfigFile> configsWithExtensionHeaders, string prologue,
+                                             IncludeDirectoryResolver resolver, CastXmlRunner castXml)
+    {
+        var headerFile = cppHeaderGenerator.GeneratePrecompiledHeader(
+            config, configsWithHeaders, configsWithExtensionHeaders, prologue, resolver.IsSystemInclude
+        );
+
+        if (headerFile == null)
+        {
+            SharpGenLogger.Message("No system include starts the C++ headers, skipping the precompiled header.");
+            return null;
+        }
+
+        var precompiledHeaderFile = Path.ChangeExtension(headerFile, "pch");
+        var dependencyFile = precompiledHeaderFile + ".d";
+        var keyFile = precompiledHeaderFile + ".key";
+
+        var key = ComputePrecompiledHeaderKey(headerFile, resolver);
+
+        if (IsPrecompiledHeaderUpToDate(precompiledHeaderFile, keyFile, key))
+        {
+            SharpGenLogger.Message("Precompiled header is up-to-date.");
+            return precompiledHeaderFile;
+        }
+
+        File.Delete(keyFile);
+
+        if (!castXml.GeneratePrecompiledHeader(headerFile, precompiledHeaderFile, dependencyFile))
+            return null;
+
+        // Without the dependencies, the precompiled header is built again by the next runs
+        if (File.Exists(dependencyFile))
+        {
+            StringBuilder keyContents = new();
+            keyContents.Append(PrecompiledHeaderKeyMarker).AppendLine(key);
+
+            foreach (var dependency in ReadMakefileDependencies(File.ReadAllText(dependencyFile)))
+            {
+                FileInfo file = new(dependency);
+                if (!file.Exists)
+                    continue;
+
+                keyContents.Append(ComputeInputsCacheFileMetadata(file)).Append(' ').AppendLine(file.FullName);
+            }
+
+            File.WriteAllText(keyFile, keyContents.ToString(), DefaultEncoding);
+        }
+
+        return precompiledHeaderFile;
+    }
+
+    private string ComputePrecompiledHeaderKey(string headerFile, IncludeDirectoryResolver resolver)
+    {
+        StringBuilder key = new();
+        key.AppendLine(CastXmlExecutable);
+        key.AppendLine(ComputeInputsCacheFileMetadata(CastXmlExecutable!));
+        key.AppendLine(string.Join(" ", CastXmlArguments!));
+        key.AppendLine(string.Join(" ", resolver.IncludeArguments));
+        key.Append(File.ReadAllText(headerFile));
+
+        return FileHashCache.ComputeHash(DefaultEncoding.GetBytes(key.ToString()));
+    }
+
+    private static bool IsPrecompiledHeaderUpToDate(string precompiledHeaderFile, string keyFile, string key)
+    {
+        if (!File.Exists(precompiledHeaderFile) || !File.Exists(keyFile))
+            return false;
+
+        var lines = File.ReadAllLines(keyFile, DefaultEncoding);
+
+        if (lines.Length == 0 || lines[0] != PrecompiledHeaderKeyMarker + key)
+            return false;
+
+        foreach (var line in lines.Skip(1))
+        {
+            // <creation time> <last write time> <size> <path>
+            var items = line.Split(SpaceSeparator, 4);
+            if (items.Length != 4)
+                return false;
+
+            FileInfo file = new(items[3]);
+            if (!file.Exists || ComputeInputsCacheFileMetadata(file) != $"{items[0]} {items[1]} {items[2]}")
+                return false;
+        }
+
+        return true;
+    }
+
+    /// <summary>
+    /// Reads the prerequisites of a dependency file written by clang <c>-MD</c>.
+    /// </summary>
+    private static IReadOnlyList<string> ReadMakefileDependencies(string contents)
+    {
+        List<string> dependencies = new();
+        StringBuilder path = new();
+        var inPrerequisites = false;
+
+        void EndPath()
+        {
+            if (inPrerequisites && path.Length != 0)
+                dependencies.Add(path.ToString());
+
+            path.Clear();
+        }
+
+        for (var i = 0; i < contents.Length; i++)
+        {
+            var c = contents[i];
+            var next = i + 1 < contents.Length ? contents[i + 1] : '\0';
+
+            switch (c)
+            {
+                case '\\' when next is '\r' or '\n':
+                    // Line continuation
+                    i += next == '\r' && i + 2 < contents.Length && contents[i + 2] == '\n' ? 2 : 1;
+                    EndPath();
+                    break;
+                case '\\' when next is ' ' or '#':
+                    path.Append(next);
+                    i++;
+                    break;
+                case '$' when next == '$':
+                    path.Append('$');
+                    i++;
+                    break;
+                case ':' when !inPrerequisites && next is ' ' or '\t' or '\r' or '\n' or '\0':
+                    // End of the target
+                    inPrerequisites = true;
+                    path.Clear();
+                    break;
+                case ' ' or '\t' or '\r' or '\n':
+                    EndPath();
+                    break;
+                default:
+                    path.Append(c);
+                    break;
+            }
+        }
+
+        EndPath();
+
+        return dependencies;
+    }
+}
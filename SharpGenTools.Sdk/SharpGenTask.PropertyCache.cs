@@ -120,18 +120,30 @@ public sealed partial class SharpGenTask
 
         WriteStringArray(CastXmlArguments);
         WriteString(CastXmlExecutable);
+        WriteInt(CastXmlMaxParallelism);
+        WriteBool(CastXmlPrecompiledHeader);
+        WriteBool(CastXmlSinglePass);
         WriteStringArray(ConfigFiles);
         WriteString(ConsumerBindMappingConfigId);
         WriteBool(DocumentationFailuresAsErrors);
+        WriteInt(DocumentationMaxParallelism);
         WriteStringArray(ExtensionAssemblies);
         WriteStringArray(ExternalDocumentation);
+        WriteBool(FunctionPointerImports);
+        WriteBool(FunctionPointerShadows);
+        WriteBool(GenerateTrace);
+        WriteInt(GeneratorMaxParallelism);
         WriteTaskItems(GlobalNamespaceOverrides);
         WriteStringArray(Macros);
         WriteString(IntermediateOutputDirectory);
         WriteString(PlatformName);
+        WriteBool(ReuseProcessState);
         WriteString(RuntimeIdentifier);
+        WriteString(SharedCacheDirectory);
         WriteStringArray(Platforms);
         WriteStringArray(SilenceMissingDocumentationErrorIdentifierPatterns);
+        WriteInt(TransformMaxParallelism);
+        WriteBool(WrapperIdentityCache);
 
         void WriteString(string? s, [CallerArgumentExpression("s")] string? name = null)
         {
@@ -147,6 +159,13 @@ public sealed partial class SharpGenTask
             writer.WriteLine(v);
         }
 
+        void WriteInt(int v, [CallerArgumentExpression("v")] string? name = null)
+        {
+            writer.Write(name);
+            writer.Write(": ");
+            writer.WriteLine(v);
+        }
+
         void WriteStringArray(IReadOnlyList<string>? items, [CallerArgumentExpression("items")] string? name = null)
         {
             writer.Write(name);
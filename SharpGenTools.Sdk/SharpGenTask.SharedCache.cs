@@ -0,0 +1,256 @@
+#nullable enable
+
+using System;
+using System.Collections.Generic;
+using System.IO;
+using System.Linq;
+using System.Text;
+using System.Threading;
+using SharpGen.Platform;
+
+namespace SharpGenTools.Sdk;
+
+public sealed partial class SharpGenTask
+{
+    private const string SharedCacheFormatVersion = "SharpGen CastXML output 1";
+    private const string SharedCacheCompletionFileName = ".complete";
+
+    /// <summary>
+    /// Runs CastXML through the machine-wide cache of <see cref="SharedCacheDirectory"/>.
+    /// </summary>
+    /// <param name="resolver">The include directories passed to CastXML.</param>
+    /// <param name="headerFiles">The translation units to process, in the profile directory.</param>
+    /// <param name="profileFiles">The files of the profile directory read by the translation units.</param>
+    /// <param name="includedFiles">The files included by the translation units, listed by the preprocessor.</param>
+    /// <param name="process">Runs CastXML on the given translation units.</param>
+    /// <returns>The readers over the XML outputs, in the order of <paramref name="headerFiles"/>.</returns>
+    /// <remarks>
+    /// <para>
+    /// A cache entry is a directory named after the hash of the CastXML executable and command line,
+    /// the name of the translation unit, and the contents of every file it reads. The profile files are copied
+    /// to the entry and CastXML runs on the copies. The output then doesn't depend on the location of the project,
+    /// and the parser still finds the files the output refers to.
+    /// </para>
+    /// <para>
+    /// An entry is only used once its completion file is written. A named mutex per entry makes the projects
+    /// building the same entry at the same time wait for the first one.
+    /// </para>
+    /// </remarks>
+    private IReadOnlyList<StreamReader?> ProcessWithSharedCache(IncludeDirectoryResolver resolver,
+                                                                IReadOnlyList<string> headerFiles,
+                                                                IReadOnlyCollection<string> profileFiles,
+                                                                IEnumerable<string> includedFiles,
+                                                                Func<IReadOnlyList<string>, IReadOnlyList<StreamReader?>> process)
+    {
+        if (string.IsNullOrWhiteSpace(SharedCacheDirectory))
+            return process(headerFiles);
+
+        var baseKey = ComputeSharedCacheBaseKey(
+            resolver, profileFiles.Concat(headerFiles), includedFiles
+        );
+        if (baseKey == null)
+        {
+            SharpGenLogger.Message("Some CastXML inputs can't be read, skipping the shared cache.");
+            return process(headerFiles);
+        }
+
+        var keys = headerFiles.Select(x => ComputeSharedCacheKey(baseKey, Path.GetFileName(x))).ToArray();
+        var results = new StreamReader?[headerFiles.Count];
+
+        List<int> misses = new();
+        for (var i = 0; i < headerFiles.Count; i++)
+        {
+            if ((results[i] = TryOpenSharedCacheEntry(keys[i], headerFiles[i])) == null)
+                misses.Add(i);
+            else
+                SharpGenLogger.Message("Reusing the CastXML output of [{0}] from the shared cache.", headerFiles[i]);
+        }
+
+        if (misses.Count == 0)
+            return results;
+
+        // Acquired in the same order by every process, so that the waits can't deadlock
+        List<Mutex> locks = new();
+
+        try
+        {
+            foreach (var key in misses.Select(i => keys[i]).Distinct().OrderBy(x => x, StringComparer.Ordinal))
+            {
+                Mutex entryLock = new(false, @"Global\SharpGen-CastXml-" + key);
+                locks.Add(entryLock);
+
+                if (!WaitSharedCacheLock(entryLock, key))
+                {
+                    locks.Remove(entryLock);
+                    entryLock.Dispose();
+                    return results;
+                }
+            }
+
+            // The entries may have been stored while waiting
+            misses.RemoveAll(i => (results[i] = TryOpenSharedCacheEntry(keys[i], headerFiles[i])) != null);
+
+            if (misses.Count != 0)
+                ProcessSharedCacheMisses(headerFiles, profileFiles, keys, misses, results, process);
+        }
+        finally
+        {
+            foreach (var entryLock in locks)
+            {
+                entryLock.ReleaseMutex();
+                entryLock.Dispose();
+            }
+        }
+
+        return results;
+    }
+
+    private void ProcessSharedCacheMisses(IReadOnlyList<string> headerFiles, IReadOnlyCollection<string> profileFiles,
+                                          string[] keys, List<int> misses, StreamReader?[] results,
+                                          Func<IReadOnlyList<string>, IReadOnlyList<StreamReader?>> process)
+    {
+        List<string> entryHeaders = new(misses.Count);
+
+        try
+        {
+            // CastXML runs in the entry itself, the parser looks up the files its output refers to
+            foreach (var i in misses)
+            {
+                var entry = GetSharedCacheEntry(keys[i]);
+
+                // Left by a build that failed before completing the entry
+                if (Directory.Exists(entry))
+                    Directory.Delete(entry, true);
+
+                Directory.CreateDirectory(entry);
+
+                foreach (var file in profileFiles.Append(headerFiles[i]).Where(File.Exists))
+                    File.Copy(file, Path.Combine(entry, Path.GetFileName(file)), true);
+
+                entryHeaders.Add(Path.Combine(entry, Path.GetFileName(headerFiles[i])));
+            }
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            SharpGenLogger.Message("Unable to use the shared cache: {0}", e.Message);
+
+            var uncachedReaders = process(misses.Select(i => headerFiles[i]).ToList());
+            for (var m = 0; m < misses.Count; m++)
+                results[misses[m]] = uncachedReaders[m];
+
+            return;
+        }
+
+        var readers = process(entryHeaders);
+
+        for (var m = 0; m < misses.Count; m++)
+        {
+            var i = misses[m];
+            var entry = GetSharedCacheEntry(keys[i]);
+
+            if (readers[m] is { } reader && !SharpGenLogger.HasErrors)
+            {
+                File.WriteAllText(Path.Combine(entry, SharedCacheCompletionFileName), headerFiles[i], DefaultEncoding);
+                results[i] = reader;
+                continue;
+            }
+
+            readers[m]?.Dispose();
+
+            try
+            {
+                Directory.Delete(entry, true);
+            }
+            catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+            {
+                SharpGenLogger.Message("Unable to delete [{0}]: {1}", entry, e.Message);
+            }
+        }
+    }
+
+    private bool WaitSharedCacheLock(Mutex entryLock, string key)
+    {
+        try
+        {
+            while (!entryLock.WaitOne(TimeSpan.FromSeconds(5)))
+            {
+                if (AbortExecution)
+                    return false;
+
+                SharpGenLogger.Message($"Waiting for another build to store the shared cache entry {key}…");
+            }
+        }
+        catch (AbandonedMutexException)
+        {
+            // The entry isn't complete, the build owning the lock failed before
+        }
+
+        return true;
+    }
+
+    private string GetSharedCacheEntry(string key) => Path.Combine(SharedCacheDirectory!, key);
+
+    private StreamReader? TryOpenSharedCacheEntry(string key, string headerFile)
+    {
+        var entry = GetSharedCacheEntry(key);
+        var xmlFile = Path.Combine(entry, Path.ChangeExtension(Path.GetFileName(headerFile), "xml"));
+
+        try
+        {
+            return File.Exists(Path.Combine(entry, SharedCacheCompletionFileName)) ? File.OpenText(xmlFile) : null;
+        }
+        catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+        {
+            return null;
+        }
+    }
+
+    /// <returns>The key, or <c>null</c> if one of the inputs can't be read.</returns>
+    private string? ComputeSharedCacheBaseKey(IncludeDirectoryResolver resolver, IEnumerable<string> profileFiles,
+                                              IEnumerable<string> includedFiles)
+    {
+        FileHashCache hashes = new();
+        StringBuilder key = new();
+
+        key.AppendLine(SharedCacheFormatVersion);
+        key.AppendLine(CastXmlExecutable);
+        key.AppendLine(ComputeInputsCacheFileMetadata(CastXmlExecutable!));
+        key.AppendLine(string.Join(" ", CastXmlArguments!));
+        key.AppendLine(string.Join(" ", resolver.IncludeArguments));
+
+        // The files of the profile directory are copied to the cache entry, only their names matter
+        foreach (var file in profileFiles.Where(File.Exists)
+                                             .Distinct(StringComparer.OrdinalIgnoreCase)
+                                             .OrderBy(x => x, StringComparer.OrdinalIgnoreCase))
+        {
+            if (hashes.GetHash(file) is not { } hash)
+                return null;
+
+            key.Append(Path.GetFileName(file)).Append(' ').AppendLine(hash);
+        }
+
+        var profilePath = Path.GetFullPath(ProfilePath);
+        foreach (var file in includedFiles.Select(Path.GetFullPath)
+                                          .Where(x => !x.StartsWith(profilePath, StringComparison.OrdinalIgnoreCase))
+                                          .Distinct(StringComparer.OrdinalIgnoreCase)
+                                          .OrderBy(x => x, StringComparer.OrdinalIgnoreCase))
+        {
+            if (hashes.GetHash(file) is not { } hash)
+                return null;
+
+            key.Append(file).Append(' ').AppendLine(hash);
+        }
+
+        return key.ToString();
+    }
+
+    private static string ComputeSharedCacheKey(string baseKey, string headerFileName)
+    {
+        var hash = Convert.FromBase64String(
+            FileHashCache.ComputeHash(DefaultEncoding.GetBytes(baseKey + headerFileName))
+        );
+
+        // Base64 isn't usable as a file name on case-insensitive file systems
+        return BitConverter.ToString(hash).Replace("-", string.Empty);
+    }
+}
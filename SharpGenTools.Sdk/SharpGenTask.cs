@@ -8,9 +8,9 @@ using System.Linq;
 using System.Text;
 using System.Text.RegularExpressions;
 using System.Threading;
-using System.Xml;
 using Microsoft.Build.Framework;
 using Microsoft.Build.Utilities;
+using Microsoft.CodeAnalysis;
 using Microsoft.CodeAnalysis.CSharp;
 using SharpGen;
 using SharpGen.Config;
@@ -41,16 +41,25 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
     private volatile bool isCancellationRequested;
     private Mutex? workerLock;
     private bool workerLockAcquired, regenerationStarted;
+    private TraceRecorder? traceRecorder;
 
     // ReSharper disable MemberCanBePrivate.Global, UnusedAutoPropertyAccessor.Global
     [Required] public string[]? CastXmlArguments { get; set; }
     [Required] public string? CastXmlExecutable { get; set; }
+    public int CastXmlMaxParallelism { get; set; } = 1;
+    public bool CastXmlPrecompiledHeader { get; set; }
+    public bool CastXmlSinglePass { get; set; }
     [Required] public string[]? ConfigFiles { get; set; }
     [Required] public string? ConsumerBindMappingConfigId { get; set; }
     [Required] public bool DebugWaitForDebuggerAttach { get; set; }
     [Required] public bool DocumentationFailuresAsErrors { get; set; }
+    public int DocumentationMaxParallelism { get; set; } = 4;
     [Required] public string[]? ExtensionAssemblies { get; set; }
     [Required] public string[]? ExternalDocumentation { get; set; }
+    public bool FunctionPointerImports { get; set; }
+    public bool FunctionPointerShadows { get; set; }
+    public bool GenerateTrace { get; set; }
+    public int GeneratorMaxParallelism { get; set; } = 1;
     [Required] public ITaskItem[]? GlobalNamespaceOverrides { get; set; }
     [Required] public string[]? Macros { get; set; }
     [Required] public string? IntermediateOutputDirectory { get; set; }
@@ -69,14 +78,20 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
         }
     }
 
+    public bool ReuseProcessState { get; set; }
     public string? RuntimeIdentifier { get; set; }
+    public string? SharedCacheDirectory { get; set; }
     [Required] public string[]? SilenceMissingDocumentationErrorIdentifierPatterns { get; set; }
+    public int TransformMaxParallelism { get; set; } = 1;
+    public bool WrapperIdentityCache { get; set; }
     // ReSharper restore UnusedAutoPropertyAccessor.Global, MemberCanBePrivate.Global
 
+    private const string GeneratedCodeFilePattern = "SharpGen.Bindings*.g.cs";
     private string GeneratedCodeFile => GetProfileChild("SharpGen.Bindings.g.cs");
     private string InputsCache => GetProfileChild("InputsCache.txt");
     private string PropertyCache => GetProfileChild("PropertyCache.txt");
     private string DocumentationCache => GetProfileChild("DocumentationCache.json");
+    private string TraceFile => GetProfileChild("Trace.json");
     private string DirtyMarkerFile => GetProfileChild("dirty");
     private string PackagePropsFile => GetProfileChild("Package.props");
 
@@ -179,6 +194,20 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
                 }
             }
 
+            if (regenerationStarted && traceRecorder != null)
+            {
+                try
+                {
+                    traceRecorder.WriteChromeTrace(TraceFile);
+                }
+                catch (Exception e) when (e is IOException or UnauthorizedAccessException)
+                {
+                    SharpGenLogger.LogRawMessage(LogLevel.Warning, null, "Unable to write the trace file", e);
+                }
+            }
+
+            PhaseTrace.Recorder = null;
+
             if (success && !AbortExecution && File.Exists(DirtyMarkerFile))
                 File.Delete(DirtyMarkerFile);
 
@@ -197,6 +226,11 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
         File.WriteAllBytes(DirtyMarkerFile, Array.Empty<byte>());
         regenerationStarted = true;
 
+        if (GenerateTrace)
+            PhaseTrace.Recorder = traceRecorder = new TraceRecorder();
+
+        using var executionPhase = PhaseTrace.Begin("SharpGen");
+
         if (AbortExecution)
             return false;
 
@@ -206,7 +240,8 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
         serviceContainer.AddService(new TypeRegistry(ioc));
         ioc.ConfigureServices(serviceContainer);
 
-        ExtensibilityDriver.Instance.LoadExtensions(SharpGenLogger, ExtensionAssemblies);
+        using (PhaseTrace.Begin("Load extensions"))
+            ExtensibilityDriver.Instance.LoadExtensions(SharpGenLogger, ExtensionAssemblies);
         AddInputsCacheFiles(ExtensionAssemblies);
 
         ConfigFile config = new()
@@ -226,7 +261,9 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
 
         CppHeaderGenerator cppHeaderGenerator = new(ProfilePath, ioc);
 
-        var cppHeaderGenerationResult = cppHeaderGenerator.GenerateCppHeaders(config, configsWithHeaders, configsWithExtensionHeaders);
+        CppHeaderGenerator.Result cppHeaderGenerationResult;
+        using (PhaseTrace.Begin("Generate headers"))
+            cppHeaderGenerationResult = cppHeaderGenerator.GenerateCppHeaders(config, configsWithHeaders, configsWithExtensionHeaders);
 
         if (AbortExecution)
             return false;
@@ -240,40 +277,158 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
             OutputPath = ProfilePath
         };
 
-        var module = config.CreateSkeletonModule();
-
-        MacroManager macroManager = new(castXml);
-        macroManager.Parse(Path.Combine(ProfilePath, config.HeaderFileName), module);
-        AddInputsCacheFiles(macroManager.IncludedFiles);
-
-        new CppExtensionHeaderGenerator().GenerateExtensionHeaders(
-            config, ProfilePath, module, configsWithExtensionHeaders, cppHeaderGenerationResult.UpdatedConfigs
-        );
-
-        AddInputsCacheFiles(configsWithExtensionHeaders.Select(x => Path.Combine(ProfilePath, x.ExtensionFileName)));
-
-        if (AbortExecution)
-            return false;
+        var extensionHeaders = configsWithExtensionHeaders.Select(x => Path.Combine(ProfilePath, x.ExtensionFileName))
+                                                          .ToList();
 
-        // Run the parser
         var parser = new CppParser(config, ioc)
         {
             OutputPath = ProfilePath
         };
 
-        if (AbortExecution)
-            return false;
+        // The per config file shards are preprocessed by their own CastXML run
+        var singlePass = CastXmlSinglePass && CastXmlMaxParallelism == 1;
+
+        CppModuleSnapshot moduleSnapshot = new(
+            Path.Combine(ProfilePath, config.Id + ".cppmodel"),
+            ComputeModuleSnapshotKey(parser, castXml, singlePass),
+            ioc
+        );
 
-        CppModule group;
+        CppModule? group;
+        using (PhaseTrace.Begin("Load C++ module snapshot"))
+            group = moduleSnapshot.TryLoad();
 
-        using (var xmlReader = castXml.Process(parser.RootConfigHeaderFileName))
+        if (group != null)
         {
-            // Run the C++ parser
-            group = parser.Run(module, xmlReader);
+            SharpGenLogger.Message("C++ module snapshot is up to date, skipping C++ parsing.");
+
+            AddInputsCacheFiles(moduleSnapshot.IncludedFiles);
+            AddInputsCacheFiles(extensionHeaders);
         }
+        else
+        {
+            var module = config.CreateSkeletonModule();
 
-        if (AbortExecution)
-            return false;
+            var preprocessedFile = Path.Combine(ProfilePath, config.Id + ".ii");
+
+            MacroManager macroManager = new(castXml);
+            using (PhaseTrace.Begin("Preprocess macros"))
+            {
+                if (singlePass)
+                    macroManager.Parse(parser.RootConfigHeaderFileName, preprocessedFile, module);
+                else
+                    macroManager.Parse(parser.RootConfigHeaderFileName, module);
+            }
+            AddInputsCacheFiles(macroManager.IncludedFiles);
+
+            new CppExtensionHeaderGenerator().GenerateExtensionHeaders(
+                config, ProfilePath, module, configsWithExtensionHeaders, cppHeaderGenerationResult.UpdatedConfigs
+            );
+
+            AddInputsCacheFiles(extensionHeaders);
+
+            if (AbortExecution)
+                return false;
+
+            // Run the parser
+            var shards = CastXmlMaxParallelism != 1
+                             ? cppHeaderGenerator.GenerateShardHeaders(
+                                 configsWithHeaders, configsWithExtensionHeaders, cppHeaderGenerationResult.Prologue
+                             )
+                             : Array.Empty<CastXmlShard>();
+
+            // The profile files read by the translation units, mirrored by the shared cache entries
+            var profileFiles = configsWithHeaders.Select(x => Path.Combine(ProfilePath, x.HeaderFileName))
+                                                 .Append(parser.RootConfigHeaderFileName)
+                                                 .Concat(extensionHeaders)
+                                                 .ToList();
+
+            if (shards.Count > 1)
+            {
+                IReadOnlyList<StreamReader?> xmlReaders;
+                using (PhaseTrace.Begin("Run CastXML"))
+                {
+                    xmlReaders = ProcessWithSharedCache(
+                        resolver, shards.Select(static shard => shard.HeaderFile).ToList(), profileFiles,
+                        macroManager.IncludedFiles,
+                        headerFiles => castXml.Process(
+                            headerFiles,
+                            CastXmlMaxParallelism > 0 ? CastXmlMaxParallelism : Environment.ProcessorCount
+                        )
+                    );
+                }
+
+                try
+                {
+                    // Run the C++ parser
+                    using (PhaseTrace.Begin("Parse CastXML output"))
+                        group = parser.Run(module, shards, xmlReaders);
+                }
+                finally
+                {
+                    foreach (var xmlReader in xmlReaders)
+                        xmlReader?.Dispose();
+                }
+            }
+            else
+            {
+                var headerFile = singlePass
+                                     ? cppHeaderGenerator.GenerateSinglePassHeader(
+                                         config, configsWithExtensionHeaders, preprocessedFile
+                                     )
+                                     : parser.RootConfigHeaderFileName;
+
+                if (singlePass)
+                    profileFiles.Add(preprocessedFile);
+
+                // The preprocessed translation unit of the single pass already contains the system headers
+                if (CastXmlPrecompiledHeader && !singlePass)
+                {
+                    using (PhaseTrace.Begin("Precompile headers"))
+                    {
+                        castXml.PrecompiledHeader = PreparePrecompiledHeader(
+                            config, cppHeaderGenerator, configsWithHeaders, configsWithExtensionHeaders,
+                            cppHeaderGenerationResult.Prologue, resolver, castXml
+                        );
+                    }
+                }
+
+                StreamReader? xmlReader;
+                using (PhaseTrace.Begin("Run CastXML"))
+                {
+                    xmlReader = ProcessWithSharedCache(
+                        resolver, new[] { headerFile }, profileFiles, macroManager.IncludedFiles,
+                        headerFiles => headerFiles.Select(castXml.Process).ToList()
+                    )[0];
+                }
+
+                // Build the precompiled header again next time, clang rejects it when its options change
+                if (castXml.PrecompiledHeaderRejected)
+                    File.Delete(castXml.PrecompiledHeader);
+
+                // Run the C++ parser
+                using (xmlReader)
+                using (PhaseTrace.Begin("Parse CastXML output"))
+                    group = parser.Run(module, xmlReader);
+            }
+
+            if (AbortExecution)
+            {
+                moduleSnapshot.Delete();
+                return false;
+            }
+
+            // Snapshot the module before the mapping rules are applied to it
+            using var snapshotPhase = PhaseTrace.Begin("Save C++ module snapshot");
+            moduleSnapshot.Save(
+                group,
+                configsWithHeaders.Select(x => Path.Combine(ProfilePath, x.HeaderFileName))
+                                  .Append(parser.RootConfigHeaderFileName)
+                                  .Concat(extensionHeaders)
+                                  .Append(CastXmlExecutable!),
+                macroManager.IncludedFiles
+            );
+        }
 
         config.ExpandDynamicVariables(SharpGenLogger, group);
 
@@ -306,7 +461,10 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
         serviceContainer.AddService(
             new GeneratorConfig
             {
-                Platforms = ConfigPlatforms
+                Platforms = ConfigPlatforms,
+                FunctionPointerImports = FunctionPointerImports,
+                FunctionPointerShadows = FunctionPointerShadows,
+                WrapperIdentityCache = WrapperIdentityCache
             }
         );
 
@@ -315,9 +473,15 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
             namingRules,
             new ConstantManager(namingRules, ioc),
             ioc
-        );
+        )
+        {
+            MaxDegreeOfParallelism = TransformMaxParallelism
+        };
 
-        var (solution, defines) = transformer.Transform(group, config);
+        CsAssembly solution;
+        IEnumerable<DefineExtensionRule> defines;
+        using (PhaseTrace.Begin("Transform"))
+            (solution, defines) = transformer.Transform(group, config);
 
         var consumerConfig = new ConfigFile
         {
@@ -356,7 +520,10 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
 
         DocumentationLogger docLogger = new(SharpGenLogger) {MaxLevel = LogLevel.Warning};
         var docContext = new Lazy<DocumentationContext>(() => new DocumentationContext(docLogger));
-        ExtensibilityDriver.Instance.DocumentModule(SharpGenLogger, cache, solution, docContext).Wait();
+        using (PhaseTrace.Begin("Documentation"))
+            ExtensibilityDriver.Instance.DocumentModule(
+                SharpGenLogger, cache, solution, docContext, DocumentationMaxParallelism
+            ).Wait();
 
         if (docContext.IsValueCreated)
         {
@@ -443,33 +610,75 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
         if (AbortExecution)
             return false;
 
-        var documentationFiles = new Dictionary<string, XmlDocument>();
-
         AddInputsCacheFiles(ExternalDocumentation);
-        foreach (var file in ExternalDocumentation)
-        {
-            using var stream = File.OpenRead(file);
 
-            var xml = new XmlDocument();
-            xml.Load(stream);
-            documentationFiles.Add(file, xml);
-        }
+        (string File, IEnumerable<string> CommentIds)[] externalDocumentation;
+        using (PhaseTrace.Begin("Load external documentation"))
+            externalDocumentation = LoadExternalDocumentation();
 
         if (AbortExecution)
             return false;
 
-        serviceContainer.AddService(new ExternalDocCommentsReader(documentationFiles));
+        serviceContainer.AddService(new ExternalDocCommentsReader(externalDocumentation));
         serviceContainer.AddService<IGeneratorRegistry>(new DefaultGenerators(ioc));
 
         RoslynGenerator generator = new();
 
-        using var codeStream = File.Open(GeneratedCodeFile, FileMode.Create, FileAccess.Write);
-        using var codeWriter = new StreamWriter(codeStream, DefaultEncoding);
-        generator.Run(solution, ioc).GetCompilationUnitRoot().WriteTo(codeWriter);
+        HashSet<string> generatedCodeFiles = new(StringComparer.OrdinalIgnoreCase) { GeneratedCodeFile };
+
+        if (GeneratorMaxParallelism != 1)
+        {
+            var trees = generator.RunPerNamespace(solution, ioc, GeneratorMaxParallelism);
+
+            // The module initializer lands in the main file, which is always written
+            WriteGeneratedCode(GeneratedCodeFile, trees.FirstOrDefault(x => x.Namespace == null).Tree);
+
+            foreach (var (ns, tree) in trees)
+            {
+                if (ns == null)
+                    continue;
+
+                var file = GetProfileChild($"SharpGen.Bindings.{ns}.g.cs");
+
+                // Namespaces only differing by case would overwrite each other on case-insensitive file systems
+                for (var i = 1; !generatedCodeFiles.Add(file); i++)
+                    file = GetProfileChild($"SharpGen.Bindings.{ns}.{i}.g.cs");
+
+                WriteGeneratedCode(file, tree);
+            }
+        }
+        else
+        {
+            WriteGeneratedCode(GeneratedCodeFile, generator.Run(solution, ioc));
+        }
+
+        foreach (var file in Directory.EnumerateFiles(ProfilePath, GeneratedCodeFilePattern))
+        {
+            if (!generatedCodeFiles.Contains(file))
+                File.Delete(file);
+        }
 
         return !SharpGenLogger.HasErrors;
     }
 
+    private void WriteGeneratedCode(string file, SyntaxTree? tree)
+    {
+        using var phase = PhaseTrace.Begin("Write generated code");
+        using CacheFile cacheFile = new(new FileInfo(file));
+
+        {
+            using var writer = cacheFile.StreamWriter;
+
+            tree?.GetCompilationUnitRoot().WriteTo(writer);
+        }
+
+        // Keep the timestamp of unchanged code, so that it doesn't trigger a recompilation
+        if (cacheFile.IsWriteNeeded)
+            cacheFile.Write();
+        else
+            SharpGenLogger.Message("Generated code file {0} is already up-to-date.", file);
+    }
+
     private PlatformDetectionType ConfigPlatforms
     {
         get
@@ -497,20 +706,40 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
         }
     }
 
+    private string ComputeModuleSnapshotKey(CppParser parser, CastXmlRunner castXml, bool singlePass)
+    {
+        // The executable contents are checked with the snapshot inputs
+        StringBuilder key = new(parser.ConfigurationKey);
+        key.AppendLine();
+        key.Append(castXml.ConfigurationKey);
+        key.Append("SinglePass=").AppendLine(singlePass.ToString());
+        key.Append("Shards=").AppendLine((CastXmlMaxParallelism != 1).ToString());
+        key.Append("PrecompiledHeader=").AppendLine(CastXmlPrecompiledHeader.ToString());
+
+        return key.ToString();
+    }
+
     private void GenerateConfigForConsumers(ConfigFile consumerConfig)
     {
-        using var consumerBindMapping = File.Create(ConsumerBindMappingConfig);
+        using CacheFile cacheFile = new(new FileInfo(ConsumerBindMappingConfig));
+
+        consumerConfig.Write(cacheFile.OutputStream);
 
-        consumerConfig.Write(consumerBindMapping);
+        if (cacheFile.IsWriteNeeded)
+            cacheFile.Write();
+        else
+            SharpGenLogger.Message("Consumer bind mapping file is already up-to-date.");
     }
 
     private void LoadConfig(ConfigFile config)
     {
-        config.Load(null, Macros, SharpGenLogger);
+        using (PhaseTrace.Begin("Load config"))
+            config.Load(null, Macros, SharpGenLogger);
 
         AddInputsCacheEnvironmentVariable("SHARPGEN_VS_OVERRIDE");
         AddInputsCacheEnvironmentVariable("SHARPGEN_SDK_OVERRIDE");
 
+        using var sdkPhase = PhaseTrace.Begin("Resolve SDKs");
         SdkResolver sdkResolver = new(SharpGenLogger);
         SharpGenLogger.Message("Resolving SDKs...");
         foreach (var cfg in config.ConfigFilesLoaded)
@@ -519,7 +748,11 @@ public sealed partial class SharpGenTask : Task, ICancelableTask
             foreach (var sdk in cfg.Sdks)
             {
                 SharpGenLogger.Message("Resolving {0}: Version {1}", sdk.Name, sdk.Version);
-                foreach (var directory in sdkResolver.ResolveIncludeDirsForSdk(sdk))
+                var directories = ReuseProcessState
+                                      ? ProcessStateCache.ResolveIncludeDirsForSdk(sdkResolver, sdk, SharpGenLogger)
+                                      : sdkResolver.ResolveIncludeDirsForSdk(sdk);
+
+                foreach (var directory in directories)
                 {
                     SharpGenLogger.Message("Resolved include directory {0}", directory);
                     cfg.IncludeDirs.Add(directory);